@@ -0,0 +1,16 @@
+#pragma once
+
+#include <atomic>
+
+// Cooperative cancellation flag shared between whoever requests a stop and the code doing
+// the work. Long loops poll cancelled() at bounded intervals (a relaxed load) and return
+// early with their data left consistent.
+class CancellationToken
+{
+public:
+    void cancel() { m_cancelled.store(true, std::memory_order_relaxed); }
+    bool cancelled() const { return m_cancelled.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic_bool m_cancelled { false };
+};
@@ -0,0 +1,52 @@
+#include "ConstructionWorker.h"
+
+#include <random>
+
+// swaps per random tour (same as the Java app)
+static constexpr int kRandomSwaps = 10000;
+
+ConstructionWorker::ConstructionWorker(Heuristic heuristic,
+                                       std::shared_ptr<Tour> tour,
+                                       QObject* parent)
+: QObject(parent), m_heuristic(heuristic), m_tour(std::move(tour))
+{
+}
+
+void ConstructionWorker::cancel()
+{
+    // thread-safe; called from the GUI thread while run() is busy
+    m_cancel.cancel();
+}
+
+void ConstructionWorker::run()
+{
+    if (!m_tour)
+    {
+        emit finished(false);
+        return;
+    }
+
+    // the heuristics report often; only whole percents reach the GUI
+    auto report = [this](double fraction){
+        const int percent = static_cast<int>(fraction * 100.0);
+        if (percent == m_percent) return;
+        m_percent = percent;
+        emit progress(percent);
+    };
+
+    bool completed = false;
+    switch (m_heuristic)
+    {
+        case Heuristic::Random:
+        {
+            std::mt19937 rng(std::random_device{}());
+            m_tour->randomize(kRandomSwaps, rng);
+            completed = !m_cancel.cancelled();
+            break;
+        }
+        case Heuristic::Easy:     completed = m_tour->easyHeuristic(&m_cancel, report); break;
+        case Heuristic::Thorough: completed = m_tour->thoroughHeuristic(&m_cancel, report); break;
+    }
+
+    emit finished(completed);
+}
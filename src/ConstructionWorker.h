@@ -0,0 +1,38 @@
+#pragma once
+
+#include <QObject>
+#include <memory>
+
+#include "CancellationToken.h"
+#include "Tour.h"
+
+// Runs one construction heuristic on its own thread. The heuristic works on a tour the
+// caller handed over and shares with the finished() handler; the caller keeps showing its
+// own tour and swaps the result in once finished(true) arrives, so nobody ever sees a half
+// built tour. cancel() may be called from any thread; the heuristic notices it within a
+// few insertions and leaves the tour as it was.
+class ConstructionWorker : public QObject
+{
+    Q_OBJECT
+public:
+    enum class Heuristic { Random, Easy, Thorough };
+
+    ConstructionWorker(Heuristic heuristic,
+                       std::shared_ptr<Tour> tour,
+                       QObject* parent = nullptr);
+
+    void cancel();
+
+public slots:
+    void run();
+
+signals:
+    void progress(int percent);
+    void finished(bool completed);
+
+private:
+    Heuristic m_heuristic;
+    std::shared_ptr<Tour> m_tour;
+    CancellationToken m_cancel;
+    int m_percent = -1; // last reported
+};
@@ -8,27 +8,21 @@
 #include <QLabel>
 #include <QMessageBox>
 #include <QMenuBar>
+#include <QProgressBar>
 #include <QPushButton>
 #include <QSlider>
 #include <QStatusBar>
+#include <QStringList>
 #include <QThread>
+#include <QTimer>
 
 #include "TspWidget.h"
-#include "optim/OptimizerWorker.h"
-#include "optim/GeneticOptimizer.h"
-#include "optim/SimAnnealOptimizer.h"
-#include "optim/TwoOptOptimizer.h"
-#include "optim/IlsOptimizer.h"
+#include "OptimizerWorker.h"
+#include "optim/OptimizerFactory.h"
+#include "optim/PortfolioOptimizer.h"
+#include "optim/IlsPoolOptimizer.h"
 
-#include <fstream>
-
-static QVector<int> toQVector(const std::vector<int>& v)
-{
-    QVector<int> out;
-    out.reserve(static_cast<int>(v.size()));
-    for (int x : v) out.push_back(x);
-    return out;
-}
+#include <algorithm>
 
 static std::vector<int> identityOrder(int n)
 {
@@ -69,6 +63,10 @@ MainWindow::MainWindow(QWidget* parent)
     m_view = new TspWidget(this);
     setCentralWidget(m_view);
 
+    // While an optimizer runs, the view pulls its latest best tour at this rate
+    m_refreshTimer = new QTimer(this);
+    setRefreshRate(30);
+
     // Status bar widgets (bottom controls)
     m_startStopButton = new QPushButton(tr("Stopped"), this);
     m_startStopButton->setEnabled(false);
@@ -77,10 +75,8 @@ MainWindow::MainWindow(QWidget* parent)
     m_improvementLabel->setEnabled(false);
 
     m_methodCombo = new QComboBox(this);
-    m_methodCombo->addItem(QStringLiteral("Genetic Algorithm (GA)"));
-    m_methodCombo->addItem(QStringLiteral("Simulated Annealing (SA)"));
-    m_methodCombo->addItem(QStringLiteral("2-opt Local Search"));
-    m_methodCombo->addItem(QStringLiteral("Iterated Local Search (ILS)"));
+    for (const OptimizerPreset& preset : optimizerPresets())
+        m_methodCombo->addItem(QString::fromUtf8(preset.description));
     m_methodCombo->setEnabled(false);
 
     m_zoomSlider = new QSlider(Qt::Horizontal, this);
@@ -106,6 +102,15 @@ MainWindow::MainWindow(QWidget* parent)
     statusBar()->addWidget(m_angleCombo);
     statusBar()->addWidget(m_linesCheck);
 
+    m_statsLabel = new QLabel(this);
+    statusBar()->addPermanentWidget(m_statsLabel);
+
+    m_constructionProgress = new QProgressBar(this);
+    m_constructionProgress->setRange(0, 100);
+    m_constructionProgress->setMaximumWidth(160);
+    m_constructionProgress->hide();
+    statusBar()->addPermanentWidget(m_constructionProgress);
+
     // Connections
     connect(m_actionOpen,   &QAction::triggered, this, &MainWindow::openTsp);
     connect(m_actionProps,  &QAction::triggered, this, &MainWindow::showProperties);
@@ -116,7 +121,10 @@ MainWindow::MainWindow(QWidget* parent)
     connect(m_actionEasy,      &QAction::triggered, this, &MainWindow::easyHeuristic);
     connect(m_actionThorough,  &QAction::triggered, this, &MainWindow::thoroughHeuristic);
     connect(m_actionStart,     &QAction::triggered, this, &MainWindow::startOptimization);
-    connect(m_actionStop,      &QAction::triggered, this, &MainWindow::stopOptimization);
+    connect(m_actionStop,      &QAction::triggered, this, [this](){
+        cancelConstruction();
+        stopOptimization();
+    });
 
     connect(m_actionViewOriginal, &QAction::triggered, this, &MainWindow::viewOriginal);
     connect(m_actionViewBest,     &QAction::triggered, this, &MainWindow::viewBest);
@@ -128,20 +136,24 @@ MainWindow::MainWindow(QWidget* parent)
     });
 
     connect(m_startStopButton, &QPushButton::clicked, this, [this](){
-        if (m_thread) stopOptimization();
+        if (m_constructionThread) cancelConstruction();
+        else if (m_thread) stopOptimization();
         else startOptimization();
     });
 
     connect(m_zoomSlider, &QSlider::valueChanged, this, &MainWindow::onZoomChanged);
     connect(m_angleCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &MainWindow::onAngleChanged);
     connect(m_linesCheck, &QCheckBox::toggled, this, &MainWindow::onShowLinesToggled);
+    connect(m_refreshTimer, &QTimer::timeout, this, &MainWindow::pullBest);
 
     setLoadedState(false);
 }
 
 MainWindow::~MainWindow()
 {
+    cancelConstruction();
     stopOptimization();
+    waitForStoppedRuns();
 }
 
 void MainWindow::setLoadedState(bool loaded)
@@ -191,7 +203,12 @@ void MainWindow::openTsp()
     if (path.isEmpty())
         return;
 
+    // the optimizers and construction jobs still winding down point into the instance we
+    // are about to replace
+    cancelConstruction();
     stopOptimization();
+    waitForStoppedRuns();
+    m_stoppedSnapshots.reset();
 
     try
     {
@@ -210,7 +227,7 @@ void MainWindow::openTsp()
         m_view->setBorderScale(static_cast<double>(m_zoomSlider->value()) / 10.0);
         m_view->setRotationDeg(m_angleCombo->currentText().toInt());
         m_view->setShowLines(m_linesCheck->isChecked());
-        m_view->setTour(toQVector(m_current.order()));
+        m_view->setTour(makeTourSnapshot(m_current));
         m_view->clearLastTour();
 
         setLoadedState(true);
@@ -256,60 +273,106 @@ void MainWindow::exportTour()
     if (!outPath.endsWith(".tour", Qt::CaseInsensitive))
         outPath += ".tour";
 
-    std::ofstream out(outPath.toStdString());
-    if (!out.is_open())
+    try
     {
-        QMessageBox::critical(this, tr("Error"), tr("Could not write the output file."));
-        return;
+        m_best.saveToTourFile(outPath.toStdString());
     }
-
-    const auto& pts = m_instance->points();
-    const auto& ord = m_best.order();
-
-    for (int i = 0; i < static_cast<int>(ord.size()); ++i)
+    catch (const std::exception&)
     {
-        const auto& p = pts[ord[i]];
-        out << (i + 1) << " " << (static_cast<double>(p.x) / 10000.0) << " " << (static_cast<double>(p.y) / 10000.0) << "\n";
+        QMessageBox::critical(this, tr("Error"), tr("Could not write the output file."));
     }
-    out.flush();
 }
 
 void MainWindow::randomizeTour()
 {
-    if (!m_instance) return;
-    stopOptimization();
-
-    std::mt19937 rng(std::random_device{}());
-    m_current.randomize(10000, rng);
+    startConstruction(ConstructionWorker::Heuristic::Random);
+}
 
-    if (m_current.cost() < m_best.cost())
-        m_best = m_current;
+void MainWindow::easyHeuristic()
+{
+    startConstruction(ConstructionWorker::Heuristic::Easy);
+}
 
-    m_view->setTour(toQVector(m_current.order()));
+void MainWindow::thoroughHeuristic()
+{
+    startConstruction(ConstructionWorker::Heuristic::Thorough);
 }
 
-void MainWindow::easyHeuristic()
+void MainWindow::startConstruction(ConstructionWorker::Heuristic heuristic)
 {
     if (!m_instance) return;
     stopOptimization();
+    cancelConstruction();
+
+    // the job builds on its own copy; m_current stays on screen until the result is swapped in
+    m_constructionTour = std::make_shared<Tour>(m_current);
+
+    m_constructionThread = new QThread(this);
+    m_construction = new ConstructionWorker(heuristic, m_constructionTour);
+
+    m_construction->moveToThread(m_constructionThread);
+
+    connect(m_constructionThread, &QThread::started, m_construction, &ConstructionWorker::run);
+    connect(m_construction, &ConstructionWorker::progress, this,
+            [this, tour = m_constructionTour](int percent){
+                if (tour == m_constructionTour)
+                    m_constructionProgress->setValue(percent);
+            },
+            Qt::QueuedConnection);
+    connect(m_construction, &ConstructionWorker::finished, this,
+            [this, tour = m_constructionTour](bool completed){ onConstructionFinished(tour, completed); },
+            Qt::QueuedConnection);
+    connect(m_construction, &ConstructionWorker::finished, m_constructionThread, &QThread::quit);
+
+    connect(m_constructionThread, &QThread::finished, m_construction, &QObject::deleteLater);
+    connect(m_constructionThread, &QThread::finished, m_constructionThread, &QObject::deleteLater);
+
+    m_constructionProgress->setValue(0);
+    m_constructionProgress->show();
+    m_startStopButton->setText(tr("Cancel"));
+    m_constructionThread->start();
+}
 
-    m_current.easyHeuristic();
-    if (m_current.cost() < m_best.cost())
-        m_best = m_current;
+void MainWindow::cancelConstruction()
+{
+    if (!m_constructionThread)
+        return;
 
-    m_view->setTour(toQVector(m_current.order()));
+    // Asynchronous like stopOptimization(): the job gives up within a few insertions and
+    // its thread deletes itself; the result it may still report is no longer wanted.
+    m_construction->cancel();
+    m_constructionThread->quit();
+
+    m_constructionThread = nullptr;
+    m_construction = nullptr;
+    m_constructionTour.reset();
+
+    m_constructionProgress->hide();
+    m_startStopButton->setText(tr("Stopped"));
 }
 
-void MainWindow::thoroughHeuristic()
+void MainWindow::onConstructionFinished(const std::shared_ptr<Tour>& tour, bool completed)
 {
-    if (!m_instance) return;
-    stopOptimization();
+    // cancelled or superseded by a newer job
+    if (tour != m_constructionTour)
+        return;
+
+    m_constructionThread = nullptr;
+    m_construction = nullptr;
+    m_constructionTour.reset();
+
+    m_constructionProgress->hide();
+    m_startStopButton->setText(tr("Stopped"));
+
+    if (!completed)
+        return;
 
-    m_current.thoroughHeuristic();
+    // the worker is done with the tour; swap it in as a whole
+    m_current = std::move(*tour);
     if (m_current.cost() < m_best.cost())
         m_best = m_current;
 
-    m_view->setTour(toQVector(m_current.order()));
+    m_view->setTour(makeTourSnapshot(m_current));
 }
 
 void MainWindow::startOptimization()
@@ -317,29 +380,35 @@ void MainWindow::startOptimization()
     if (!m_instance || m_thread)
         return;
 
+    // optimize the tour on screen, not the one still being built
+    cancelConstruction();
+
     // baseline always refers to the original tour (same as Java)
     m_baseline = m_original.cost();
 
-    std::unique_ptr<IOptimizer> optimizer;
-    const int method = m_methodCombo->currentIndex();
+    // the combo lists the presets in order
+    const auto& presets = optimizerPresets();
+    const int method = std::clamp(m_methodCombo->currentIndex(), 0, static_cast<int>(presets.size()) - 1);
+    std::unique_ptr<IOptimizer> optimizer = makeOptimizer(presets[method].name, m_current);
+    m_portfolio = dynamic_cast<PortfolioOptimizer*>(optimizer.get());
+    m_ilsPool = dynamic_cast<IlsPoolOptimizer*>(optimizer.get());
 
-    switch (method)
-    {
-        case 0: optimizer = std::make_unique<GeneticOptimizer>(m_current, 30, 2); break;
-        case 1: optimizer = std::make_unique<SimAnnealOptimizer>(m_current); break;
-        case 2: optimizer = std::make_unique<TwoOptOptimizer>(m_current); break;
-        case 3: optimizer = std::make_unique<IlsOptimizer>(m_current); break;
-        default: optimizer = std::make_unique<SimAnnealOptimizer>(m_current); break;
-    }
+    m_statsLabel->clear();
+    m_statsLabel->setToolTip(QString());
+
+    m_snapshots = std::make_shared<BestSnapshotBuffer>();
 
     m_thread = new QThread(this);
-    m_worker = new OptimizerWorker(std::move(optimizer));
+    m_worker = new OptimizerWorker(std::move(optimizer), m_snapshots, m_termination);
 
     m_worker->moveToThread(m_thread);
 
     connect(m_thread, &QThread::started, m_worker, &OptimizerWorker::run);
-    connect(m_worker, &OptimizerWorker::bestUpdated, this, &MainWindow::onBestUpdated, Qt::QueuedConnection);
-    connect(m_worker, &OptimizerWorker::finished, this, &MainWindow::onWorkerFinished, Qt::QueuedConnection);
+    connect(m_worker, &OptimizerWorker::finished, this,
+            [this, snapshots = m_snapshots](TerminationReason reason, double stopLatencyMs){
+                onWorkerFinished(snapshots, reason, stopLatencyMs);
+            },
+            Qt::QueuedConnection);
     connect(m_worker, &OptimizerWorker::finished, m_thread, &QThread::quit);
 
     connect(m_thread, &QThread::finished, m_worker, &QObject::deleteLater);
@@ -347,6 +416,7 @@ void MainWindow::startOptimization()
 
     m_startStopButton->setText(tr("Running"));
     m_thread->start();
+    m_refreshTimer->start();
 }
 
 void MainWindow::stopOptimization()
@@ -354,67 +424,184 @@ void MainWindow::stopOptimization()
     if (!m_thread)
         return;
 
+    // Asynchronous: cancel and let the thread finish on its own. The worker's last
+    // publication arrives with finished(), see onWorkerFinished().
     if (m_worker)
         m_worker->stop();
-
-    // thread will quit when worker emits finished()
-    // but we also force a polite interruption in case it is in a long iterate
-    m_thread->requestInterruption();
     m_thread->quit();
-    m_thread->wait();
+
+    showOptimizerStats();
+    m_portfolio = nullptr;
+    m_ilsPool = nullptr;
 
     m_thread = nullptr;
     m_worker = nullptr;
 
+    m_refreshTimer->stop();
+    pullBest();
+    m_stoppedSnapshots = std::move(m_snapshots);
+
+    // the snapshot already carries the cost, so there is nothing to re-evaluate
+    if (m_bestSnapshot)
+    {
+        m_best.order().assign(m_bestSnapshot->order.begin(), m_bestSnapshot->order.end());
+        m_best.setCost(m_bestSnapshot->cost);
+    }
+
     m_startStopButton->setText(tr("Stopped"));
 
     // make current equal to best at stop (like Java behavior)
     if (m_instance)
     {
         m_current = m_best;
-        m_view->setTour(toQVector(m_current.order()));
+        if (m_bestSnapshot)
+            m_view->setTour(std::move(m_bestSnapshot));
+        else
+            m_view->setTour(makeTourSnapshot(m_current));
     }
+    m_bestSnapshot.reset();
+}
+
+void MainWindow::waitForStoppedRuns()
+{
+    // stopped threads are our children until they delete themselves; each exits within
+    // one cancelled step
+    for (QThread* thread : findChildren<QThread*>())
+        thread->wait();
 }
 
 void MainWindow::viewOriginal()
 {
     if (!m_instance) return;
+    cancelConstruction();
     stopOptimization();
     m_current = m_original;
     m_view->clearLastTour();
-    m_view->setTour(toQVector(m_current.order()));
+    m_view->setTour(makeTourSnapshot(m_current));
 }
 
 void MainWindow::viewBest()
 {
     if (!m_instance) return;
+    cancelConstruction();
     stopOptimization();
     m_current = m_best;
     m_view->clearLastTour();
-    m_view->setTour(toQVector(m_current.order()));
+    m_view->setTour(makeTourSnapshot(m_current));
 }
 
-void MainWindow::onBestUpdated(const QVector<int>& bestOrder, double bestCost, double improvementPct)
+void MainWindow::setRefreshRate(int hz)
 {
-    if (!m_instance) return;
+    m_refreshTimer->setInterval(1000 / std::max(1, hz));
+}
+
+void MainWindow::pullBest()
+{
+    if (!m_instance || !m_snapshots) return;
 
-    // update best tour
-std::vector<int> ord;
-ord.reserve(bestOrder.size());
-for (int v : bestOrder) ord.push_back(v);
-m_best = Tour(&(*m_instance), std::move(ord));
-    // keep cost if we wanted; Tour evaluates already.
-    (void)bestCost;
+    showOptimizerStats();
+
+    // only the latest snapshot matters; older improvements were coalesced by the buffer
+    if (!m_snapshots->update())
+        return;
+    const BestSnapshot& snapshot = m_snapshots->front();
+
+    // keep a reference to the best tour; m_best is only brought up to date on stop
+    m_bestSnapshot = snapshot.tour;
 
     // show the best in the view (blue), leaving last (red)
-    m_view->setTour(bestOrder);
+    m_view->setTour(m_bestSnapshot);
+
+    m_improvementLabel->setText(tr("Improvement: %1%").arg(snapshot.improvementPercent, 0, 'f', 3));
+}
+
+void MainWindow::showOptimizerStats()
+{
+    showPortfolioStats();
+    showIlsPoolStats();
+}
+
+void MainWindow::showPortfolioStats()
+{
+    if (!m_portfolio) return;
+
+    const auto stats = m_portfolio->stats();
+    double totalGain = 0.0;
+    for (const auto& s : stats) totalGain += s.gain;
 
-    m_improvementLabel->setText(tr("Improvement: %1%").arg(improvementPct, 0, 'f', 3));
+    // label: share of the global improvement per child; tooltip: the full counters
+    QStringList shares;
+    QStringList details;
+    for (const auto& s : stats)
+    {
+        const double share = (totalGain > 0.0) ? (s.gain / totalGain * 100.0) : 0.0;
+        const QString name = QString::fromStdString(s.name);
+        shares << tr("%1 %2%").arg(name).arg(share, 0, 'f', 0);
+        details << tr("%1: best %2, %3 global bests, %4 batches, %5 elite injections")
+                       .arg(name).arg(s.bestCost, 0, 'f', 0).arg(s.globalBests).arg(s.batches).arg(s.injections);
+    }
+    m_statsLabel->setText(shares.join(QStringLiteral(" | ")));
+    m_statsLabel->setToolTip(details.join(QLatin1Char('\n')));
+}
+
+void MainWindow::showIlsPoolStats()
+{
+    if (!m_ilsPool) return;
+
+    // label: throughput of the whole pool; tooltip: per chain
+    const std::vector<double> rates = m_ilsPool->kicksPerSecond();
+    double total = 0.0;
+    QStringList details;
+    for (size_t c = 0; c < rates.size(); ++c)
+    {
+        total += rates[c];
+        details << tr("Chain %1: %2 kicks/s").arg(c + 1).arg(rates[c], 0, 'f', 0);
+    }
+    m_statsLabel->setText(tr("%1 chains, %2 kicks/s").arg(rates.size()).arg(total, 0, 'f', 0));
+    m_statsLabel->setToolTip(details.join(QLatin1Char('\n')));
 }
 
-void MainWindow::onWorkerFinished()
+void MainWindow::onWorkerFinished(const std::shared_ptr<BestSnapshotBuffer>& snapshots,
+                                  TerminationReason reason, double stopLatencyMs)
 {
-    // worker finished, thread is already quitting
+    if (reason == TerminationReason::Cancelled)
+    {
+        m_startStopButton->setToolTip(tr("Last stop took %1 ms").arg(stopLatencyMs, 0, 'f', 1));
+    }
+    else if (snapshots == m_snapshots)
+    {
+        // a termination criterion ended the running optimizer: stop it as if the user had,
+        // then report why
+        stopOptimization();
+
+        const QString why = QString::fromLatin1(terminationReasonName(reason));
+        m_startStopButton->setText(tr("Stopped: %1").arg(why));
+        m_startStopButton->setToolTip(tr("The run ended by itself (%1)").arg(why));
+    }
+
+    // only the run stopped last can still matter; a newly opened instance drops it
+    if (snapshots != m_stoppedSnapshots)
+        return;
+    m_stoppedSnapshots.reset();
+
+    // an improvement found after the stop request that the refresh timer never saw
+    if (!snapshots->update())
+        return;
+    const BestSnapshot& snapshot = snapshots->front();
+    if (!snapshot.tour || !(snapshot.tour->cost < m_best.cost()))
+        return;
+
+    // still showing the result of that stop: move the view along with it
+    const bool showingStop = !m_thread && m_current.cost() == m_best.cost();
+
+    m_best.order().assign(snapshot.tour->order.begin(), snapshot.tour->order.end());
+    m_best.setCost(snapshot.tour->cost);
+    if (showingStop)
+    {
+        m_current = m_best;
+        m_view->setTour(snapshot.tour);
+        m_improvementLabel->setText(tr("Improvement: %1%").arg(snapshot.improvementPercent, 0, 'f', 3));
+    }
 }
 
 void MainWindow::onZoomChanged(int v)
@@ -7,6 +7,9 @@
 
 #include "TspInstance.h"
 #include "Tour.h"
+#include "TourSnapshot.h"
+#include "ConstructionWorker.h"
+#include "optim/TerminationCriteria.h"
 
 class TspWidget;
 class QLabel;
@@ -14,9 +17,15 @@ class QPushButton;
 class QSlider;
 class QComboBox;
 class QCheckBox;
+class QProgressBar;
 class QThread;
+class QTimer;
 
 class OptimizerWorker;
+class PortfolioOptimizer;
+class IlsPoolOptimizer;
+struct BestSnapshot;
+template <typename T> class TripleBuffer;
 
 class MainWindow : public QMainWindow
 {
@@ -25,6 +34,12 @@ public:
     explicit MainWindow(QWidget* parent = nullptr);
     ~MainWindow() override;
 
+    // How often the view pulls the optimizer's latest best tour while it runs.
+    void setRefreshRate(int hz);
+
+    // When optimizer runs end by themselves; by default they run until stopped.
+    void setTerminationCriteria(const TerminationCriteria& criteria) { m_termination = criteria; }
+
 private slots:
     void openTsp();
     void showProperties();
@@ -40,8 +55,7 @@ private slots:
     void viewOriginal();
     void viewBest();
 
-    void onBestUpdated(const QVector<int>& bestOrder, double bestCost, double improvementPct);
-    void onWorkerFinished();
+    void pullBest();
 
     void onZoomChanged(int v);
     void onAngleChanged(int idx);
@@ -50,6 +64,15 @@ private slots:
 private:
     void setLoadedState(bool loaded);
     void updateTitle();
+    void showOptimizerStats();
+    void showPortfolioStats();
+    void showIlsPoolStats();
+    void waitForStoppedRuns();
+    void startConstruction(ConstructionWorker::Heuristic heuristic);
+    void cancelConstruction();
+    void onConstructionFinished(const std::shared_ptr<Tour>& tour, bool completed);
+    void onWorkerFinished(const std::shared_ptr<TripleBuffer<BestSnapshot>>& snapshots,
+                          TerminationReason reason, double stopLatencyMs);
 
     std::optional<TspInstance> m_instance;
 
@@ -86,6 +109,20 @@ private:
     // Worker thread
     QThread* m_thread = nullptr;
     OptimizerWorker* m_worker = nullptr;
+    std::shared_ptr<TripleBuffer<BestSnapshot>> m_snapshots;
+    std::shared_ptr<TripleBuffer<BestSnapshot>> m_stoppedSnapshots; // run still winding down
+    QTimer* m_refreshTimer = nullptr;
+    TourSnapshotPtr m_bestSnapshot; // latest best pulled from the worker
+    PortfolioOptimizer* m_portfolio = nullptr; // owned by the worker; only set while it runs
+    IlsPoolOptimizer* m_ilsPool = nullptr;     // likewise
+    QLabel* m_statsLabel = nullptr;            // live counters of the two above
+    TerminationCriteria m_termination;
+
+    // Construction thread (random tour / insertion heuristics)
+    QThread* m_constructionThread = nullptr;
+    ConstructionWorker* m_construction = nullptr;
+    std::shared_ptr<Tour> m_constructionTour; // result of the job still wanted
+    QProgressBar* m_constructionProgress = nullptr;
 
     QString m_currentFile;
 };
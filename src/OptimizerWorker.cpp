@@ -0,0 +1,91 @@
+#include "OptimizerWorker.h"
+#include <QThread>
+
+#include "optim/OptimizerRun.h"
+
+OptimizerWorker::OptimizerWorker(std::unique_ptr<IOptimizer> optimizer,
+                                 std::shared_ptr<BestSnapshotBuffer> snapshots,
+                                 const TerminationCriteria& criteria,
+                                 QObject* parent)
+: QObject(parent), m_optimizer(std::move(optimizer)), m_snapshots(std::move(snapshots)), m_criteria(criteria)
+{
+    if (m_optimizer)
+        m_optimizer->setCancellation(&m_cancel);
+}
+
+void OptimizerWorker::stop()
+{
+    // thread-safe; called from the GUI thread while run() is busy
+    const auto now = IOptimizer::Clock::now().time_since_epoch().count();
+    IOptimizer::Clock::rep expected = 0;
+    m_stopRequested.compare_exchange_strong(expected, now, std::memory_order_relaxed);
+    m_cancel.cancel();
+}
+
+std::shared_ptr<TourSnapshot> OptimizerWorker::freeSnapshot()
+{
+    // a snapshot only the pool still references is no longer visible to anyone else
+    for (auto& s : m_snapshotPool)
+    {
+        if (s.use_count() == 1)
+        {
+            // pairs with the release decrement of the reader that dropped it last
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return s;
+        }
+    }
+    m_snapshotPool.push_back(std::make_shared<TourSnapshot>());
+    return m_snapshotPool.back();
+}
+
+void OptimizerWorker::publishBest()
+{
+    const Tour& best = m_optimizer->bestTour();
+    const double baseline = m_optimizer->baselineCost();
+
+    std::shared_ptr<TourSnapshot> tour = freeSnapshot();
+    tour->order.assign(best.order().begin(), best.order().end());
+    tour->cost = best.cost();
+
+    BestSnapshot& s = m_snapshots->back();
+    s.tour = std::move(tour);
+    s.improvementPercent = (baseline > 0.0) ? ((baseline - best.cost()) / baseline * 100.0) : 0.0;
+    m_snapshots->publish();
+}
+
+void OptimizerWorker::run()
+{
+    if (!m_optimizer || !m_snapshots)
+    {
+        emit finished(TerminationReason::Cancelled, 0.0);
+        return;
+    }
+
+    bool pending = false;
+    const RunResult result = runOptimizer(*m_optimizer, m_criteria, &m_cancel, kSlice, [&](bool improved){
+        pending = pending || improved;
+
+        // coalesce: copy the best tour only once the GUI has taken the previous snapshot
+        if (pending && !m_snapshots->unread())
+        {
+            publishBest();
+            pending = false;
+        }
+
+        // Yield a bit so the GUI stays responsive even on single-core systems.
+        QThread::yieldCurrentThread();
+    });
+
+    if (pending)
+        publishBest();
+
+    if (result.reason != TerminationReason::Cancelled)
+    {
+        emit finished(result.reason, 0.0);
+        return;
+    }
+
+    const IOptimizer::Clock::time_point requested(IOptimizer::Clock::duration(m_stopRequested.load(std::memory_order_relaxed)));
+    emit finished(TerminationReason::Cancelled,
+                  std::chrono::duration<double, std::milli>(IOptimizer::Clock::now() - requested).count());
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <QObject>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "TourSnapshot.h"
+#include "optim/IOptimizer.h"
+#include "optim/TerminationCriteria.h"
+#include "optim/TripleBuffer.h"
+
+// Latest best tour as seen by the GUI.
+struct BestSnapshot
+{
+    TourSnapshotPtr tour;
+    double improvementPercent = 0.0;
+};
+using BestSnapshotBuffer = TripleBuffer<BestSnapshot>;
+
+// Runs an optimizer on its own thread, in time-sliced batches so that cheap steps are not
+// dominated by the per-step stop check and yield. stop() only cancels the optimizer's token
+// and returns; the worker emits finished() once the running step has noticed it.
+// Improvements are not pushed to the GUI; the worker publishes them into a triple buffer
+// that the GUI polls on its refresh timer. A new snapshot is only copied once the GUI has
+// taken the previous one, so the optimizer thread never blocks. Snapshot objects are
+// recycled once the GUI has let go of them, so after the first few the worker does not
+// allocate to report progress either. The batch loop is runOptimizer(), which also ends the
+// run by itself once one of the termination criteria holds.
+class OptimizerWorker : public QObject
+{
+    Q_OBJECT
+public:
+    OptimizerWorker(std::unique_ptr<IOptimizer> optimizer,
+                    std::shared_ptr<BestSnapshotBuffer> snapshots,
+                    const TerminationCriteria& criteria = {},
+                    QObject* parent = nullptr);
+
+public slots:
+    void run();
+    void stop();
+
+signals:
+    // reason: the criterion that ended the run, Cancelled after stop()
+    // stopLatencyMs: time from stop() to the end of run(), last publication included (0 if
+    // a criterion fired)
+    void finished(TerminationReason reason, double stopLatencyMs);
+
+private:
+    void publishBest();
+    std::shared_ptr<TourSnapshot> freeSnapshot();
+
+    // optimizer time per batch; bounds both the stop latency and the publication rate
+    static constexpr std::chrono::milliseconds kSlice { 4 };
+
+    // declared before the optimizer, which polls it until it is destroyed
+    CancellationToken m_cancel;
+    std::atomic<IOptimizer::Clock::rep> m_stopRequested { 0 };
+
+    std::unique_ptr<IOptimizer> m_optimizer;
+    std::shared_ptr<BestSnapshotBuffer> m_snapshots;
+    TerminationCriteria m_criteria;
+    std::vector<std::shared_ptr<TourSnapshot>> m_snapshotPool; // owned here, shared read-only
+};
@@ -0,0 +1,180 @@
+#include "SpatialGrid.h"
+#include "Tour.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+SpatialGrid::SpatialGrid(const TspInstance& instance)
+: m_instance(&instance)
+{
+    const int n = instance.size();
+    if (n == 0) return;
+
+    const double w = static_cast<double>(instance.maxX()) - static_cast<double>(instance.minX()) + 1.0;
+    const double h = static_cast<double>(instance.maxY()) - static_cast<double>(instance.minY()) + 1.0;
+
+    // square cells, ~2 points per cell on average
+    const double cellArea = std::max(1.0, (w * h) * 2.0 / static_cast<double>(n));
+    m_cellSize = std::max<int64_t>(1, static_cast<int64_t>(std::ceil(std::sqrt(cellArea))));
+    m_cols = std::max(1, static_cast<int>(std::ceil(w / static_cast<double>(m_cellSize))));
+    m_rows = std::max(1, static_cast<int>(std::ceil(h / static_cast<double>(m_cellSize))));
+
+    const auto& pts = instance.points();
+    std::vector<int> cellOf(static_cast<size_t>(n));
+    m_start.assign(static_cast<size_t>(m_cols) * static_cast<size_t>(m_rows) + 1, 0);
+
+    for (int i = 0; i < n; ++i)
+    {
+        const int c = cellY(pts[i].y) * m_cols + cellX(pts[i].x);
+        cellOf[i] = c;
+        ++m_start[static_cast<size_t>(c) + 1];
+    }
+    for (size_t c = 1; c < m_start.size(); ++c)
+        m_start[c] += m_start[c - 1];
+
+    m_items.resize(static_cast<size_t>(n));
+    std::vector<int> fill(m_start.begin(), m_start.end() - 1);
+    for (int i = 0; i < n; ++i)
+        m_items[static_cast<size_t>(fill[cellOf[i]]++)] = i;
+}
+
+int SpatialGrid::cellX(int32_t x) const
+{
+    const int64_t c = (static_cast<int64_t>(x) - m_instance->minX()) / m_cellSize;
+    return static_cast<int>(std::clamp<int64_t>(c, 0, m_cols - 1));
+}
+
+int SpatialGrid::cellY(int32_t y) const
+{
+    const int64_t c = (static_cast<int64_t>(y) - m_instance->minY()) / m_cellSize;
+    return static_cast<int>(std::clamp<int64_t>(c, 0, m_rows - 1));
+}
+
+void SpatialGrid::kNearest(int node, int k, std::vector<int>& out) const
+{
+    out.clear();
+    const int n = m_instance ? m_instance->size() : 0;
+    k = std::min(k, n - 1);
+    if (k <= 0) return;
+
+    const auto& pts = m_instance->points();
+    const TspPoint& q = pts[node];
+    const int cx = cellX(q.x);
+    const int cy = cellY(q.y);
+
+    // bounded max-heap of (distance, id)
+    std::vector<std::pair<double,int>> heap;
+    heap.reserve(static_cast<size_t>(k) + 1);
+
+    const int maxRing = std::max(m_cols, m_rows);
+    for (int r = 0; r <= maxRing; ++r)
+    {
+        const int x0 = cx - r, x1 = cx + r;
+        const int y0 = cy - r, y1 = cy + r;
+
+        for (int y = std::max(0, y0); y <= std::min(m_rows - 1, y1); ++y)
+        {
+            // only the ring border (full rows at the top and bottom)
+            const bool fullRow = (y == y0 || y == y1);
+            const int step = fullRow ? 1 : (x1 - x0);
+            for (int x = x0; x <= x1; x += std::max(1, step))
+            {
+                if (x < 0 || x >= m_cols) continue;
+                const int c = y * m_cols + x;
+                for (int t = m_start[c]; t < m_start[c + 1]; ++t)
+                {
+                    const int j = m_items[t];
+                    if (j == node) continue;
+                    const double d = Tour::edgeCost(q, pts[j]);
+                    if (static_cast<int>(heap.size()) < k)
+                    {
+                        heap.emplace_back(d, j);
+                        std::push_heap(heap.begin(), heap.end());
+                    }
+                    else if (d < heap.front().first)
+                    {
+                        std::pop_heap(heap.begin(), heap.end());
+                        heap.back() = {d, j};
+                        std::push_heap(heap.begin(), heap.end());
+                    }
+                }
+            }
+        }
+
+        // anything beyond ring r is at least r * cellSize away
+        if (static_cast<int>(heap.size()) == k &&
+            heap.front().first <= static_cast<double>(r) * static_cast<double>(m_cellSize))
+            break;
+    }
+
+    std::sort_heap(heap.begin(), heap.end());
+    for (const auto& e : heap) out.push_back(e.second);
+}
+
+int SpatialGrid::nearestUnmarked(int node, const char* marked, int maxCells) const
+{
+    const int n = m_instance ? m_instance->size() : 0;
+    if (n == 0) return -1;
+
+    const auto& pts = m_instance->points();
+    const TspPoint& q = pts[node];
+    const int cx = cellX(q.x);
+    const int cy = cellY(q.y);
+
+    int best = -1;
+    double bestD = std::numeric_limits<double>::infinity();
+    int cells = 0;
+
+    const int maxRing = std::max(m_cols, m_rows);
+    for (int r = 0; r <= maxRing; ++r)
+    {
+        const int x0 = cx - r, x1 = cx + r;
+        const int y0 = cy - r, y1 = cy + r;
+
+        for (int y = std::max(0, y0); y <= std::min(m_rows - 1, y1); ++y)
+        {
+            const bool fullRow = (y == y0 || y == y1);
+            const int step = fullRow ? 1 : (x1 - x0);
+            for (int x = x0; x <= x1; x += std::max(1, step))
+            {
+                if (x < 0 || x >= m_cols) continue;
+                if (++cells > maxCells)
+                    return -1;
+
+                const int c = y * m_cols + x;
+                for (int t = m_start[c]; t < m_start[c + 1]; ++t)
+                {
+                    const int j = m_items[t];
+                    if (marked[j] || j == node) continue;
+                    const double d = Tour::edgeCost(q, pts[j]);
+                    if (d < bestD)
+                    {
+                        bestD = d;
+                        best = j;
+                    }
+                }
+            }
+        }
+
+        if (best >= 0 && bestD <= static_cast<double>(r) * static_cast<double>(m_cellSize))
+            break;
+    }
+    return best;
+}
+
+std::vector<int> SpatialGrid::buildNeighborLists(int K) const
+{
+    const int n = m_instance ? m_instance->size() : 0;
+    K = std::max(0, std::min(K, n - 1));
+
+    std::vector<int> lists(static_cast<size_t>(n) * static_cast<size_t>(K));
+    std::vector<int> tmp;
+    for (int i = 0; i < n; ++i)
+    {
+        kNearest(i, K, tmp);
+        std::copy(tmp.begin(), tmp.end(), lists.begin() + static_cast<size_t>(i) * static_cast<size_t>(K));
+    }
+    return lists;
+}
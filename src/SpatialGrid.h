@@ -0,0 +1,39 @@
+#pragma once
+
+#include "TspInstance.h"
+#include <vector>
+
+// Uniform bucket grid over the instance points (about two points per cell).
+// Distances follow Tour::edgeCost (Chebyshev), which makes ring-by-ring search exact:
+// every point in ring r+1 around the query cell is at least r cell widths away.
+class SpatialGrid
+{
+public:
+    explicit SpatialGrid(const TspInstance& instance);
+
+    // The k nearest other points of `node`, ascending by distance (fewer if n-1 < k).
+    void kNearest(int node, int k, std::vector<int>& out) const;
+
+    // Flat neighbor lists: entries [i*K, (i+1)*K) are the K nearest neighbors of i.
+    // K is clamped to n-1.
+    std::vector<int> buildNeighborLists(int K) const;
+
+    // Nearest point to `node` with marked[j] == 0, found by the ring search, or -1 if the
+    // search would have to look at more than maxCells cells before the answer is certain
+    // (or no unmarked point exists). The result is always exact.
+    int nearestUnmarked(int node, const char* marked, int maxCells) const;
+
+private:
+    int cellX(int32_t x) const;
+    int cellY(int32_t y) const;
+
+    const TspInstance* m_instance = nullptr;
+
+    int64_t m_cellSize = 1;
+    int m_cols = 1;
+    int m_rows = 1;
+
+    // CSR buckets: points of cell c are m_items[m_start[c] .. m_start[c+1])
+    std::vector<int> m_start;
+    std::vector<int> m_items;
+};
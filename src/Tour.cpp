@@ -1,6 +1,9 @@
 #include "Tour.h"
+#include "optim/TaskScheduler.h"
 #include <algorithm>
 #include <cmath>
+#include <fstream>
+#include <limits>
 #include <stdexcept>
 
 Tour::Tour(const TspInstance* instance)
@@ -46,6 +49,24 @@ double Tour::evaluate()
     return m_cost;
 }
 
+void Tour::saveToTourFile(const std::string& path) const
+{
+    std::ofstream out(path);
+    if (!out.is_open())
+        throw std::runtime_error("Could not write the output file: " + path);
+
+    const auto& pts = m_instance->points();
+    for (int i = 0; i < static_cast<int>(m_order.size()); ++i)
+    {
+        const auto& p = pts[m_order[i]];
+        out << (i + 1) << " " << (static_cast<double>(p.x) / 10000.0) << " " << (static_cast<double>(p.y) / 10000.0) << "\n";
+    }
+
+    out.flush();
+    if (!out)
+        throw std::runtime_error("Could not write the output file: " + path);
+}
+
 void Tour::randomize(int swaps, std::mt19937& rng)
 {
     if (m_order.size() < 2) return;
@@ -103,54 +124,158 @@ void Tour::mutateReverseSegment(std::mt19937& rng)
     std::reverse(m_order.begin() + i, m_order.begin() + j + 1);
 }
 
-void Tour::easyHeuristic()
+// Both insertion heuristics grow an open path one city at a time and put each city where
+// it lengthens the path least. The path is kept as points plus edge lengths, so a position
+// costs one distance: delta(p) = d(path[p-1], x) + d(x, path[p]) - edge[p-1]. Costs are
+// integral, so the deltas compare exactly like the full path lengths the Java version
+// recomputed, and ties go to the largest position, the first one its downward scan met.
+
+// below this many candidate positions a scan is cheaper than waking the scheduler
+static constexpr int kParallelInsertion = 1 << 14;
+static constexpr int kInsertionBlock = 1 << 12; // minimum positions per parallel block
+
+// insertions between progress reports and cancellation checks
+static constexpr int kReportInterval = 64;
+
+namespace
 {
-    if (!m_instance || m_order.size() < 3) return;
+    struct Insertion
+    {
+        double delta = std::numeric_limits<double>::infinity();
+        int pos = -1;
+    };
+
+    struct GrowingPath
+    {
+        std::vector<int> order;
+        std::vector<TspPoint> pts;
+        std::vector<double> edge; // edge[k] = d(pts[k], pts[k + 1])
+
+        void reserve(int n)
+        {
+            order.reserve(n);
+            pts.reserve(n);
+            edge.reserve(n);
+        }
+
+        void append(int city, const TspPoint& p)
+        {
+            if (!pts.empty())
+                edge.push_back(Tour::edgeCost(pts.back(), p));
+            order.push_back(city);
+            pts.push_back(p);
+        }
+
+        // best interior position in [a, b] (1 <= a, b < size), scanned upwards
+        Insertion scan(const TspPoint& x, int a, int b) const
+        {
+            Insertion best;
+            double left = Tour::edgeCost(pts[a - 1], x);
+            for (int p = a; p <= b; ++p)
+            {
+                const double right = Tour::edgeCost(x, pts[p]);
+                const double delta = left + right - edge[p - 1];
+                if (delta <= best.delta)
+                {
+                    best.delta = delta;
+                    best.pos = p;
+                }
+                left = right;
+            }
+            return best;
+        }
+
+        // best interior position in [a, b]; long ranges are split over the shared scheduler
+        Insertion cheapest(const TspPoint& x, int a, int b) const
+        {
+            const int span = b - a + 1;
+            TaskScheduler& pool = TaskScheduler::instance();
+            const int blocks = std::min(pool.size(), span / kInsertionBlock);
+            if (span < kParallelInsertion || blocks < 2)
+                return scan(x, a, b);
+
+            std::vector<Insertion> found(static_cast<size_t>(blocks));
+            pool.parallelFor(0, blocks, [&](int blk){
+                const int lo = a + static_cast<int>(static_cast<long long>(span) * blk / blocks);
+                const int hi = a + static_cast<int>(static_cast<long long>(span) * (blk + 1) / blocks) - 1;
+                found[blk] = scan(x, lo, hi);
+            });
+
+            // later blocks hold larger positions, so <= keeps the tie rule
+            Insertion best;
+            for (const Insertion& f : found)
+            {
+                if (f.delta <= best.delta)
+                    best = f;
+            }
+            return best;
+        }
 
+        void insert(int pos, int city, const TspPoint& p)
+        {
+            if (pos == 0)
+            {
+                edge.insert(edge.begin(), Tour::edgeCost(p, pts[0]));
+            }
+            else if (pos == static_cast<int>(pts.size()))
+            {
+                edge.push_back(Tour::edgeCost(pts.back(), p));
+            }
+            else
+            {
+                edge[pos - 1] = Tour::edgeCost(pts[pos - 1], p);
+                edge.insert(edge.begin() + pos, Tour::edgeCost(p, pts[pos]));
+            }
+            order.insert(order.begin() + pos, city);
+            pts.insert(pts.begin() + pos, p);
+        }
+    };
+
+    // insertion i scans O(i) positions, so the work done so far grows with i^2
+    void reportProgress(const Tour::ProgressCallback& progress, int done, int total)
+    {
+        if (!progress) return;
+        const double f = static_cast<double>(done) / static_cast<double>(total);
+        progress(f * f);
+    }
+}
+
+bool Tour::easyHeuristic(const CancellationToken* cancel, const ProgressCallback& progress)
+{
+    if (!m_instance || m_order.size() < 3) return true;
+
+    const auto& pts = m_instance->points();
     const int n = static_cast<int>(m_order.size());
-    std::vector<int> newSol(n);
 
-    newSol[0] = m_order[0];
-    newSol[1] = m_order[n - 1];
+    // both ends stay fixed; every other city goes in between, in tour order
+    GrowingPath path;
+    path.reserve(n);
+    path.append(m_order[0], pts[m_order[0]]);
+    path.append(m_order[n - 1], pts[m_order[n - 1]]);
 
     for (int i = 1; i < n - 1; ++i)
     {
-        newSol[i + 1] = newSol[i];
-        newSol[i] = m_order[i];
-
-        int bestPos = i;
-        // compute partial length for first (i+2) points in newSol using helper below
-        auto partialCost = [&](int size)->double{
-            const auto& pts = m_instance->points();
-            double sum = 0.0;
-            for (int k = 0; k < size - 1; ++k)
-                sum += edgeCost(pts[newSol[k]], pts[newSol[k+1]]);
-            return sum;
-        };
-        double bestLen = partialCost(i + 2);
-
-        for (int j = i; j > 1; --j)
+        if (i % kReportInterval == 0)
         {
-            std::swap(newSol[j], newSol[j - 1]);
-            const double testLen = partialCost(i + 2);
-            if (testLen < bestLen)
-            {
-                bestLen = testLen;
-                bestPos = j - 1;
-            }
+            if (cancel && cancel->cancelled()) return false;
+            reportProgress(progress, i, n);
         }
 
-        for (int j = 1; j < bestPos; ++j)
-            std::swap(newSol[j], newSol[j + 1]);
+        const int city = m_order[i];
+        const int last = static_cast<int>(path.pts.size()) - 1;
+        const Insertion best = path.cheapest(pts[city], 1, last);
+        path.insert(best.pos, city, pts[city]);
     }
 
-    m_order = std::move(newSol);
+    m_order = std::move(path.order);
     evaluate();
+    reportProgress(progress, 1, 1);
+    return true;
 }
 
-void Tour::thoroughHeuristic()
+bool Tour::thoroughHeuristic(const CancellationToken* cancel, const ProgressCallback& progress)
 {
-    if (!m_instance || m_order.size() < 3) return;
+    if (!m_instance || m_order.size() < 3) return true;
 
     const auto& pts = m_instance->points();
     const int n = static_cast<int>(m_order.size());
@@ -169,63 +294,56 @@ void Tour::thoroughHeuristic()
     const double cy = (static_cast<double>(maxY) - static_cast<double>(minY)) / 2.0;
 
     // compute distance-from-center for each node id and sort ids by descending distance
-    std::vector<int> ids(n);
-    for (int i = 0; i < n; ++i) ids[i] = m_order[i];
-
     std::vector<double> dist(n);
     for (int i = 0; i < n; ++i)
     {
-        const double dx = static_cast<double>(pts[ids[i]].x) - cx;
-        const double dy = static_cast<double>(pts[ids[i]].y) - cy;
+        const double dx = static_cast<double>(pts[m_order[i]].x) - cx;
+        const double dy = static_cast<double>(pts[m_order[i]].y) - cy;
         dist[i] = std::sqrt(dx*dx + dy*dy);
     }
 
-    // bubble sort (to keep behavior close to Java)
-    for (int i = 0; i < n - 1; ++i)
+    // stable, so equal distances keep tour order like the Java bubble sort did
+    std::vector<int> rank(n);
+    for (int i = 0; i < n; ++i) rank[i] = i;
+    std::stable_sort(rank.begin(), rank.end(), [&](int a, int b){ return dist[a] > dist[b]; });
+
+    GrowingPath path;
+    path.reserve(n);
+    path.append(m_order[rank[0]], pts[m_order[rank[0]]]);
+    path.append(m_order[rank[1]], pts[m_order[rank[1]]]);
+
+    for (int i = 2; i < n; ++i)
     {
-        for (int j = 0; j < n - 1 - i; ++j)
+        if (i % kReportInterval == 0)
         {
-            if (dist[j + 1] > dist[j])
-            {
-                std::swap(dist[j], dist[j + 1]);
-                std::swap(ids[j], ids[j + 1]);
-            }
+            if (cancel && cancel->cancelled()) return false;
+            reportProgress(progress, i, n);
         }
-    }
 
-    std::vector<int> newSol(n);
-    newSol[0] = ids[0];
-    newSol[1] = ids[1];
+        const int city = m_order[rank[i]];
+        const TspPoint& x = pts[city];
 
-    auto partialCost = [&](int size)->double{
-        double sum = 0.0;
-        for (int k = 0; k < size - 1; ++k)
-            sum += edgeCost(pts[newSol[k]], pts[newSol[k+1]]);
-        return sum;
-    };
+        // the ends are candidates too: scanning down, the tail comes first, the head last
+        Insertion best;
+        best.delta = edgeCost(path.pts.back(), x);
+        best.pos = i;
 
-    for (int i = 2; i < n; ++i)
-    {
-        newSol[i] = ids[i];
+        const Insertion inner = path.cheapest(x, 1, i - 1);
+        if (inner.delta < best.delta)
+            best = inner;
 
-        int bestPos = i;
-        double bestLen = partialCost(i + 1);
-
-        for (int j = i; j > 0; --j)
+        const double head = edgeCost(x, path.pts.front());
+        if (head < best.delta)
         {
-            std::swap(newSol[j], newSol[j - 1]);
-            const double testLen = partialCost(i + 1);
-            if (testLen < bestLen)
-            {
-                bestLen = testLen;
-                bestPos = j - 1;
-            }
+            best.delta = head;
+            best.pos = 0;
         }
 
-        for (int j = 0; j < bestPos; ++j)
-            std::swap(newSol[j], newSol[j + 1]);
+        path.insert(best.pos, city, x);
     }
 
-    m_order = std::move(newSol);
+    m_order = std::move(path.order);
     evaluate();
+    reportProgress(progress, 1, 1);
+    return true;
 }
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "TspInstance.h"
+#include "CancellationToken.h"
+#include <functional>
+#include <string>
 #include <vector>
 #include <random>
 #include <cstdint>
@@ -19,13 +22,24 @@ public:
 
     double cost() const { return m_cost; }
     double evaluate(); // recompute cost
+    void setCost(double c) { m_cost = c; } // for callers that track the cost incrementally (move deltas)
 
     int size() const { return static_cast<int>(m_order.size()); }
 
+    // Writes one "position x y" line per city, coordinates unscaled (the .tour export format).
+    // Throws std::runtime_error if the file cannot be written.
+    void saveToTourFile(const std::string& path) const;
+
     // Helpers (same ideas as the Java app)
     void randomize(int swaps, std::mt19937& rng);
-    void easyHeuristic();     // insertion heuristic (fast)
-    void thoroughHeuristic(); // distance-from-center sorting + insertion
+    // Construction heuristics; they return false (tour unchanged) if `cancel` fires first.
+    // `progress` receives the estimated fraction of the work done, from the calling thread.
+    // Long insertion scans are split over the shared TaskScheduler.
+    using ProgressCallback = std::function<void(double fraction)>;
+    bool easyHeuristic(const CancellationToken* cancel = nullptr,
+                       const ProgressCallback& progress = {});     // insertion heuristic (fast)
+    bool thoroughHeuristic(const CancellationToken* cancel = nullptr,
+                           const ProgressCallback& progress = {}); // distance-from-center sorting + insertion
 
     // Mutations
     void mutateSwap(std::mt19937& rng);           // swap 2 indices (excluding 0 like Java)
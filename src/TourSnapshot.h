@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Tour.h"
+#include <memory>
+#include <vector>
+
+// Immutable tour (order + cost) shared by reference between the optimizer thread, the main
+// window and the view. It is passed around as a TourSnapshotPtr, so a best tour is copied
+// once when it is published and never converted or re-evaluated afterwards.
+struct TourSnapshot
+{
+    std::vector<int> order;
+    double cost = 0.0;
+};
+using TourSnapshotPtr = std::shared_ptr<const TourSnapshot>;
+
+inline TourSnapshotPtr makeTourSnapshot(const Tour& tour)
+{
+    return std::make_shared<const TourSnapshot>(TourSnapshot{ tour.order(), tour.cost() });
+}
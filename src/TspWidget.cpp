@@ -16,30 +16,30 @@ TspWidget::TspWidget(QWidget* parent)
 void TspWidget::setInstance(const TspInstance* instance)
 {
     m_instance = instance;
-    m_current.clear();
-    m_last.clear();
+    m_current.reset();
+    m_last.reset();
     m_pan = QPointF(0.0, 0.0);
     m_dragging = false;
     unsetCursor();
     update();
 }
 
-void TspWidget::setTour(const QVector<int>& order)
+void TspWidget::setTour(TourSnapshotPtr tour)
 {
-    m_last = m_current;
-    m_current = order;
+    m_last = std::move(m_current);
+    m_current = std::move(tour);
     update();
 }
 
-void TspWidget::setLastTour(const QVector<int>& order)
+void TspWidget::setLastTour(TourSnapshotPtr tour)
 {
-    m_last = order;
+    m_last = std::move(tour);
     update();
 }
 
 void TspWidget::clearLastTour()
 {
-    m_last.clear();
+    m_last.reset();
     update();
 }
 
@@ -70,10 +70,11 @@ static inline QPointF mapPoint(const TspPoint& p, double x_scale, double y_scale
     return QPointF(x, y);
 }
 
-static void drawTour(QPainter& painter, const TspInstance& inst, const QVector<int>& ord,
+static void drawTour(QPainter& painter, const TspInstance& inst, const TourSnapshotPtr& tour,
                      double x_scale, double y_scale, int32_t minX, int32_t minY, bool showLines)
 {
-    if (ord.isEmpty()) return;
+    if (!tour || tour->order.empty()) return;
+    const std::vector<int>& ord = tour->order;
 
     const auto& pts = inst.points();
     const int radius = 1;
@@ -81,7 +82,7 @@ static void drawTour(QPainter& painter, const TspInstance& inst, const QVector<i
     QPointF prev;
     bool hasPrev = false;
 
-    for (int k = 0; k < ord.size(); ++k)
+    for (int k = 0; k < static_cast<int>(ord.size()); ++k)
     {
         const int idx = ord[k];
         if (idx < 0 || idx >= static_cast<int>(pts.size()))
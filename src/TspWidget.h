@@ -1,11 +1,11 @@
 #pragma once
 
 #include <QWidget>
-#include <QVector>
 #include <QPoint>
 #include <QPointF>
 
 #include "TspInstance.h"
+#include "TourSnapshot.h"
 
 class QMouseEvent;
 class QEvent;
@@ -17,8 +17,8 @@ public:
     explicit TspWidget(QWidget* parent = nullptr);
 
     void setInstance(const TspInstance* instance);
-    void setTour(const QVector<int>& order);   // current (blue)
-    void setLastTour(const QVector<int>& order); // last (red)
+    void setTour(TourSnapshotPtr tour);     // current (blue)
+    void setLastTour(TourSnapshotPtr tour); // last (red)
     void clearLastTour();
 
     void setBorderScale(double s); // like Java's borderSize
@@ -35,8 +35,8 @@ protected:
 private:
     const TspInstance* m_instance = nullptr;
 
-    QVector<int> m_current;
-    QVector<int> m_last;
+    TourSnapshotPtr m_current;
+    TourSnapshotPtr m_last;
 
     double m_borderScale = 1.0;
     int m_rotation = 0;
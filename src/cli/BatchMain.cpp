@@ -0,0 +1,149 @@
+// tsp-batch: solves a directory or manifest of instances, several at a time.
+//
+//   tsp-batch [options] --results results.jsonl <directory | manifest>
+//
+// Appends one JSON record per instance (see RunRecord) to the results file and echoes it
+// on stdout. Running the same command again skips the instances already solved.
+
+#include "CliOptions.h"
+#include "CancellationToken.h"
+#include "optim/BatchRunner.h"
+#include "optim/TaskScheduler.h"
+
+#include <csignal>
+#include <iostream>
+#include <string>
+
+static CancellationToken g_interrupt;
+
+static void onInterrupt(int)
+{
+    g_interrupt.cancel(); // lock-free atomic store
+}
+
+namespace
+{
+    void printUsage(std::ostream& out)
+    {
+        out << "usage: tsp-batch [options] --results FILE <directory | manifest>\n"
+               "\n"
+               "A directory is searched for *.tsp files; a manifest lists one instance per line\n"
+               "(relative to the manifest, '#' starts a comment). Instances that already have a\n"
+               "record in the results file are skipped.\n"
+               "\n"
+            << solveOptionsHelp()
+            << "  (the termination criteria apply to every instance)\n"
+               "\n"
+               "  --results FILE           JSON lines results file, appended (required)\n"
+               "  --tour-dir DIR           write each best tour to DIR/<name>.tour\n"
+               "  --jobs N                 small instances solved at once, at most one per\n"
+               "                           worker thread plus one (0 = that many)\n"
+               "  --large-cities N         instances with at least N cities run alone on all\n"
+               "                           cores (default 5000)\n"
+               "  --workers N              shared worker threads (0 = one per core)\n"
+               "  --list-methods           list the optimizer presets and their parameters\n"
+               "  --help                   show this help\n";
+    }
+
+    struct Options
+    {
+        BatchRunner::Options batch;
+        std::string source;
+        int workers = -1; // keep the default
+    };
+
+    // returns false if the program should exit without solving (help, method list)
+    bool parseArgs(int argc, char* argv[], Options& o)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            if (parseSolveOption(argc, argv, i, o.batch.spec))
+                continue;
+
+            if (arg == "--help" || arg == "-h")
+            {
+                printUsage(std::cout);
+                return false;
+            }
+            if (arg == "--list-methods")
+            {
+                printMethods();
+                return false;
+            }
+
+            auto value = [&]() -> std::string {
+                if (i + 1 >= argc)
+                    throw UsageError(arg + ": missing value");
+                return argv[++i];
+            };
+
+            if (arg == "--results")             o.batch.resultsFile = value();
+            else if (arg == "--tour-dir")       o.batch.tourDir = value();
+            else if (arg == "--jobs")           o.batch.slots = static_cast<int>(toInteger(arg, value()));
+            else if (arg == "--large-cities")   o.batch.largeCities = static_cast<int>(toInteger(arg, value()));
+            else if (arg == "--workers")        o.workers = static_cast<int>(toInteger(arg, value()));
+            else if (arg.size() > 1 && arg[0] == '-')
+                throw UsageError("unknown option: " + arg);
+            else if (o.source.empty())
+                o.source = arg;
+            else
+                throw UsageError("more than one directory or manifest given: " + arg);
+        }
+
+        if (o.source.empty())
+            throw UsageError("no directory or manifest given");
+        if (o.batch.resultsFile.empty())
+            throw UsageError("--results is required");
+        if (!o.batch.spec.criteria.any())
+            o.batch.spec.criteria.wallSeconds = kDefaultTimeLimit;
+        return true;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options o;
+    try
+    {
+        if (!parseArgs(argc, argv, o))
+            return 0;
+    }
+    catch (const UsageError& ex)
+    {
+        std::cerr << "tsp-batch: " << ex.what() << "\n\n";
+        printUsage(std::cerr);
+        return 2;
+    }
+
+    try
+    {
+        if (o.workers >= 0)
+            TaskScheduler::setWorkerCount(o.workers);
+
+        std::signal(SIGINT, onInterrupt);
+        std::signal(SIGTERM, onInterrupt);
+
+        const std::vector<std::string> instances = listInstances(o.source);
+
+        BatchRunner runner(o.batch);
+        const BatchRunner::Summary summary = runner.run(instances, &g_interrupt, [](const RunRecord& record){
+            std::cout << toJsonLine(record) << std::endl;
+        });
+
+        std::cerr << "tsp-batch: " << summary.solved << " solved, " << summary.skipped << " skipped, "
+                  << summary.failed << " failed";
+        if (summary.interrupted > 0)
+            std::cerr << ", " << summary.interrupted << " interrupted (run again to resume)";
+        std::cerr << "\n";
+
+        if (g_interrupt.cancelled())
+            return 130;
+        return summary.failed > 0 ? 1 : 0;
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "tsp-batch: " << ex.what() << "\n";
+        return 1;
+    }
+}
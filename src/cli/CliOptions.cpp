@@ -0,0 +1,95 @@
+#include "CliOptions.h"
+
+#include <iostream>
+
+double toDouble(const std::string& option, const std::string& v)
+{
+    size_t end = 0;
+    double value = 0.0;
+    try { value = std::stod(v, &end); }
+    catch (const std::exception&) { end = 0; }
+    if (end == 0 || end != v.size())
+        throw UsageError(option + ": not a number: " + v);
+    return value;
+}
+
+long long toInteger(const std::string& option, const std::string& v)
+{
+    size_t end = 0;
+    long long value = 0;
+    try { value = std::stoll(v, &end); }
+    catch (const std::exception&) { end = 0; }
+    if (end == 0 || end != v.size())
+        throw UsageError(option + ": not an integer: " + v);
+    return value;
+}
+
+bool parseSolveOption(int argc, char* argv[], int& i, SolveSpec& spec)
+{
+    const std::string arg = argv[i];
+    auto value = [&]() -> std::string {
+        if (i + 1 >= argc)
+            throw UsageError(arg + ": missing value");
+        return argv[++i];
+    };
+
+    TerminationCriteria& c = spec.criteria;
+
+    if (arg == "--method")
+    {
+        spec.method = value();
+        if (!findPreset(spec.method))
+            throw UsageError("--method: unknown method: " + spec.method);
+    }
+    else if (arg == "--param")
+    {
+        const std::string kv = value();
+        const size_t eq = kv.find('=');
+        if (eq == std::string::npos || eq == 0)
+            throw UsageError("--param: expected KEY=VALUE: " + kv);
+        spec.params.set(kv.substr(0, eq), kv.substr(eq + 1));
+    }
+    else if (arg == "--seed")              spec.params.set("seed", value());
+    else if (arg == "--init")
+    {
+        spec.init = value();
+        if (!isValidInit(spec.init))
+            throw UsageError("--init: expected file, random, easy or thorough: " + spec.init);
+    }
+    else if (arg == "--time-limit")        c.wallSeconds = toDouble(arg, value());
+    else if (arg == "--cpu-limit")         c.cpuSeconds = toDouble(arg, value());
+    else if (arg == "--max-steps")         c.maxSteps = toInteger(arg, value());
+    else if (arg == "--target-cost")       c.targetCost = toDouble(arg, value());
+    else if (arg == "--reference-cost")    c.referenceCost = toDouble(arg, value());
+    else if (arg == "--target-gap")        c.targetGapPercent = toDouble(arg, value());
+    else if (arg == "--stagnation-time")   c.stagnationSeconds = toDouble(arg, value());
+    else if (arg == "--stagnation-steps")  c.stagnationSteps = toInteger(arg, value());
+    else return false;
+
+    return true;
+}
+
+const char* solveOptionsHelp()
+{
+    return "  --method NAME            optimizer preset (default ils), see --list-methods\n"
+           "  --param KEY=VALUE        preset parameter, repeatable\n"
+           "  --seed N                 random seed (default: random, reported in the stats)\n"
+           "  --init KIND              starting tour: file (default), random, easy, thorough\n"
+           "\n"
+           "termination (default: --time-limit 10 when none is given; Ctrl+C stops the run):\n"
+           "  --time-limit S           wall-clock seconds\n"
+           "  --cpu-limit S            CPU seconds of the run (tsp-batch: per instance)\n"
+           "  --max-steps N            optimizer steps (summed over the islands, chains or\n"
+           "                           children of island, ils-pool and portfolio)\n"
+           "  --target-cost C          stop once the best costs at most C\n"
+           "  --reference-cost C       known optimum or lower bound for --target-gap\n"
+           "  --target-gap P           stop within P percent of --reference-cost\n"
+           "  --stagnation-time S      stop after S seconds without improvement\n"
+           "  --stagnation-steps N     stop after N steps without improvement\n";
+}
+
+void printMethods()
+{
+    for (const OptimizerPreset& p : optimizerPresets())
+        std::cout << p.name << "\n    " << p.description << "\n    parameters: " << p.params << " seed\n";
+}
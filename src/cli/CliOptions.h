@@ -0,0 +1,30 @@
+#pragma once
+
+#include "optim/Solve.h"
+
+#include <stdexcept>
+#include <string>
+
+// Command-line handling shared by tsp-solve and tsp-batch.
+
+struct UsageError : std::runtime_error
+{
+    using std::runtime_error::runtime_error;
+};
+
+double toDouble(const std::string& option, const std::string& value);
+long long toInteger(const std::string& option, const std::string& value);
+
+// Parses argv[i] if it is one of the solve options (method, parameters, seed, starting
+// tour, termination criteria), advancing i past its value. Returns false for other
+// arguments; throws UsageError on a bad value.
+bool parseSolveOption(int argc, char* argv[], int& i, SolveSpec& spec);
+
+// Help text for the options parseSolveOption() knows.
+const char* solveOptionsHelp();
+
+// Prints the optimizer presets and their parameters.
+void printMethods();
+
+// Run time when no termination criterion is given.
+static constexpr double kDefaultTimeLimit = 10.0;
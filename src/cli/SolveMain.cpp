@@ -0,0 +1,118 @@
+// tsp-solve: runs one optimizer on one instance without a display.
+//
+//   tsp-solve [options] instance.tsp
+//
+// Prints one JSON stats line (see RunRecord) on stdout and optionally writes the best tour.
+
+#include "CliOptions.h"
+#include "CancellationToken.h"
+#include "optim/TaskScheduler.h"
+
+#include <csignal>
+#include <iostream>
+#include <string>
+
+static CancellationToken g_interrupt;
+
+static void onInterrupt(int)
+{
+    g_interrupt.cancel(); // lock-free atomic store
+}
+
+namespace
+{
+    void printUsage(std::ostream& out)
+    {
+        out << "usage: tsp-solve [options] instance.tsp\n"
+               "\n"
+            << solveOptionsHelp()
+            << "\n"
+               "  --workers N              shared worker threads (0 = one per core)\n"
+               "  --tour PATH              write the best tour to PATH\n"
+               "  --list-methods           list the optimizer presets and their parameters\n"
+               "  --help                   show this help\n";
+    }
+
+    struct Options
+    {
+        SolveSpec spec;
+        int workers = -1; // keep the default
+    };
+
+    // returns false if the program should exit without solving (help, method list)
+    bool parseArgs(int argc, char* argv[], Options& o)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            if (parseSolveOption(argc, argv, i, o.spec))
+                continue;
+
+            if (arg == "--help" || arg == "-h")
+            {
+                printUsage(std::cout);
+                return false;
+            }
+            if (arg == "--list-methods")
+            {
+                printMethods();
+                return false;
+            }
+
+            auto value = [&]() -> std::string {
+                if (i + 1 >= argc)
+                    throw UsageError(arg + ": missing value");
+                return argv[++i];
+            };
+
+            if (arg == "--workers")             o.workers = static_cast<int>(toInteger(arg, value()));
+            else if (arg == "--tour")           o.spec.tourFile = value();
+            else if (arg.size() > 1 && arg[0] == '-')
+                throw UsageError("unknown option: " + arg);
+            else if (o.spec.instanceFile.empty())
+                o.spec.instanceFile = arg;
+            else
+                throw UsageError("more than one instance given: " + arg);
+        }
+
+        if (o.spec.instanceFile.empty())
+            throw UsageError("no instance given");
+        if (!o.spec.criteria.any())
+            o.spec.criteria.wallSeconds = kDefaultTimeLimit;
+        return true;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options o;
+    try
+    {
+        if (!parseArgs(argc, argv, o))
+            return 0;
+    }
+    catch (const UsageError& ex)
+    {
+        std::cerr << "tsp-solve: " << ex.what() << "\n\n";
+        printUsage(std::cerr);
+        return 2;
+    }
+
+    try
+    {
+        if (o.workers >= 0)
+            TaskScheduler::setWorkerCount(o.workers);
+
+        std::signal(SIGINT, onInterrupt);
+        std::signal(SIGTERM, onInterrupt);
+
+        const RunRecord record = solveInstance(o.spec, &g_interrupt);
+        std::cout << toJsonLine(record) << std::endl;
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "tsp-solve: " << ex.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
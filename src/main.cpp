@@ -1,10 +1,65 @@
 #include <QApplication>
+#include <QCommandLineParser>
 #include "MainWindow.h"
+#include "optim/TaskScheduler.h"
+#include "optim/TerminationCriteria.h"
 
 int main(int argc, char *argv[])
 {
     QApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption workersOption(QStringLiteral("workers"),
+                                     QStringLiteral("Worker threads shared by the parallel optimizers (0 = one per core)."),
+                                     QStringLiteral("n"));
+    parser.addOption(workersOption);
+
+    // termination criteria for optimizer runs (all off by default)
+    QCommandLineOption timeLimitOption(QStringLiteral("time-limit"),
+                                       QStringLiteral("End runs after this many seconds."),
+                                       QStringLiteral("s"));
+    QCommandLineOption cpuLimitOption(QStringLiteral("cpu-limit"),
+                                      QStringLiteral("End runs after this much process CPU time, in seconds."),
+                                      QStringLiteral("s"));
+    QCommandLineOption maxStepsOption(QStringLiteral("max-steps"),
+                                      QStringLiteral("End runs after this many optimizer steps."),
+                                      QStringLiteral("n"));
+    QCommandLineOption targetCostOption(QStringLiteral("target-cost"),
+                                        QStringLiteral("End runs once the best tour costs at most this."),
+                                        QStringLiteral("cost"));
+    QCommandLineOption referenceCostOption(QStringLiteral("reference-cost"),
+                                           QStringLiteral("Known optimum or lower bound for --target-gap."),
+                                           QStringLiteral("cost"));
+    QCommandLineOption targetGapOption(QStringLiteral("target-gap"),
+                                       QStringLiteral("End runs within this many percent of --reference-cost."),
+                                       QStringLiteral("percent"));
+    QCommandLineOption stagnationTimeOption(QStringLiteral("stagnation-time"),
+                                            QStringLiteral("End runs after this many seconds without improvement."),
+                                            QStringLiteral("s"));
+    QCommandLineOption stagnationStepsOption(QStringLiteral("stagnation-steps"),
+                                             QStringLiteral("End runs after this many steps without improvement."),
+                                             QStringLiteral("n"));
+    parser.addOptions({ timeLimitOption, cpuLimitOption, maxStepsOption, targetCostOption,
+                        referenceCostOption, targetGapOption, stagnationTimeOption, stagnationStepsOption });
+    parser.process(app);
+
+    if (parser.isSet(workersOption))
+        TaskScheduler::setWorkerCount(parser.value(workersOption).toInt());
+
+    TerminationCriteria criteria;
+    criteria.wallSeconds = parser.value(timeLimitOption).toDouble();
+    criteria.cpuSeconds = parser.value(cpuLimitOption).toDouble();
+    criteria.maxSteps = parser.value(maxStepsOption).toLongLong();
+    criteria.targetCost = parser.value(targetCostOption).toDouble();
+    criteria.referenceCost = parser.value(referenceCostOption).toDouble();
+    if (parser.isSet(targetGapOption))
+        criteria.targetGapPercent = parser.value(targetGapOption).toDouble();
+    criteria.stagnationSeconds = parser.value(stagnationTimeOption).toDouble();
+    criteria.stagnationSteps = parser.value(stagnationStepsOption).toLongLong();
+
     MainWindow w;
+    w.setTerminationCriteria(criteria);
     w.show();
     return app.exec();
 }
@@ -3,12 +3,10 @@
 #include <algorithm>
 #include <cmath>
 
-static inline int clampInt(int v, int lo, int hi)
-{
-    if (v < lo) return lo;
-    if (v > hi) return hi;
-    return v;
-}
+// MAX-MIN Ant System settings (Stuetzle & Hoos)
+static constexpr double kBestTourProbability = 0.05; // p_best, sets the tau_min/tau_max ratio
+static constexpr int kStagnationLimit = 100;         // iterations without a new best before a reset
+static constexpr int kCancelCheckSteps = 1024;       // construction steps between cancellation checks (power of 2)
 
 AcoOptimizer::AcoOptimizer(const Tour& initial,
                            int antsPerIteration,
@@ -18,6 +16,9 @@ AcoOptimizer::AcoOptimizer(const Tour& initial,
                            double beta,
                            double rho,
                            double q,
+                           int threads,
+                           Variant variant,
+                           bool localSearch,
                            uint32_t seed)
 : m_instance(initial.instance()),
   m_n(initial.size()),
@@ -28,13 +29,49 @@ AcoOptimizer::AcoOptimizer(const Tour& initial,
   m_beta(beta),
   m_rho(rho),
   m_Q(q),
+  m_variant(variant),
+  m_localSearch(localSearch),
   m_rng(seed),
   m_best(initial),
   m_baseline(initial.cost()),
   m_lastBest(initial.cost())
 {
     if (m_instance && m_n > 1)
+    {
+        m_grid = std::make_unique<SpatialGrid>(*m_instance);
         buildCandidateLists();
+    }
+
+    if (m_variant == Variant::MaxMin && !m_cand.empty())
+    {
+        updateTrailLimits();
+        resetTrails();
+    }
+
+    m_ants.resize(static_cast<size_t>(m_antsPerIter));
+    for (int a = 0; a < m_antsPerIter; ++a)
+    {
+        std::seed_seq seq{ seed, static_cast<uint32_t>(a) };
+        m_ants[a].rng.seed(seq);
+        m_ants[a].visited.resize(static_cast<size_t>(m_n));
+        m_ants[a].unvisited.resize(static_cast<size_t>(m_n));
+        m_ants[a].unvisitedPos.resize(static_cast<size_t>(m_n));
+        m_ants[a].order.reserve(static_cast<size_t>(m_n));
+        m_ants[a].weights.resize(static_cast<size_t>(m_candidateK));
+    }
+
+    if (threads != 1)
+    {
+        m_pool = &TaskScheduler::instance();
+        m_threads = (threads > 0) ? std::min(threads, m_pool->size()) : m_pool->size();
+    }
+
+    if (m_localSearch && !m_cand.empty())
+    {
+        const int searchers = m_pool ? m_pool->size() : 1;
+        for (int t = 0; t < searchers; ++t)
+            m_searchers.push_back(std::make_unique<TwoOptLocalSearch>(m_instance, &m_neighbors, m_K, true));
+    }
 }
 
 double AcoOptimizer::costOf(const std::vector<int>& ord) const
@@ -50,28 +87,63 @@ double AcoOptimizer::costOf(const std::vector<int>& ord) const
 
 void AcoOptimizer::buildCandidateLists()
 {
-    m_candidates.clear();
+    m_K = 0;
+    m_cand.clear();
     m_tau.clear();
+    m_etaPow.clear();
 
-    if (!m_instance || m_n <= 1)
+    // with two cities there is only one tour
+    if (!m_instance || m_n < 3)
         return;
 
     const auto& pts = m_instance->points();
 
+    if (m_localSearch)
+    {
+        // The local search needs exact neighbor lists anyway, and its tours mostly use
+        // near-neighbor edges, which must be candidates to receive pheromone.
+        m_neighbors = m_grid->buildNeighborLists(m_candidateK);
+        m_K = static_cast<int>(m_neighbors.size() / static_cast<size_t>(m_n));
+        if (m_K == 0)
+            return;
+
+        m_cand.resize(m_neighbors.size());
+        m_tau.assign(m_cand.size(), 1.0); // tau0
+        m_etaPow.resize(m_cand.size());
+        for (size_t s = 0; s < m_cand.size(); ++s)
+        {
+            const int i = static_cast<int>(s / static_cast<size_t>(m_K));
+            const double d = Tour::edgeCost(pts[i], pts[m_neighbors[s]]);
+            m_cand[s].to = m_neighbors[s];
+            m_etaPow[s] = std::pow(1.0 / (1.0 + d), m_beta);
+        }
+
+        buildEdgeSlots();
+        updateChoiceInfo();
+        return;
+    }
+
     // For very large instances, avoid O(N^2) neighbor building.
     // We approximate k-nearest neighbors by random sampling per node.
-    const int K = clampInt(m_candidateK, 4, std::max(4, m_n - 1));
+    // at most n-1 distinct neighbors exist; the random fill below relies on it
+    const int K = std::min(m_candidateK, m_n - 1);
     const int S = std::min(m_candidateSamples, std::max(10, m_n - 1));
 
     std::uniform_int_distribution<int> pick(0, m_n - 1);
 
-    m_candidates.resize(m_n);
-    m_tau.resize(m_n);
+    m_K = K;
+    m_cand.resize(static_cast<size_t>(m_n) * static_cast<size_t>(K));
+    m_tau.assign(m_cand.size(), 1.0); // tau0
+    m_etaPow.resize(m_cand.size());
+
+    std::vector<std::pair<double,int>> best;
+    best.reserve(static_cast<size_t>(K + 8));
+    std::vector<int> cand;
+    cand.reserve(K);
 
     for (int i = 0; i < m_n; ++i)
     {
-        std::vector<std::pair<double,int>> best;
-        best.reserve(static_cast<size_t>(K + 8));
+        best.clear();
 
         // sample S distinct-ish nodes (duplicates filtered cheaply)
         for (int s = 0; s < S; ++s)
@@ -102,8 +174,7 @@ void AcoOptimizer::buildCandidateLists()
                   [](const auto& a, const auto& b){ return a.first < b.first; });
 
         // unique ids
-        std::vector<int> cand;
-        cand.reserve(K);
+        cand.clear();
         for (const auto& p : best)
         {
             if (static_cast<int>(cand.size()) >= K) break;
@@ -124,171 +195,361 @@ void AcoOptimizer::buildCandidateLists()
             if (!dup) cand.push_back(j);
         }
 
-        m_candidates[i] = std::move(cand);
-        m_tau[i].assign(static_cast<size_t>(K), 1.0); // tau0
+        const size_t row = static_cast<size_t>(i) * static_cast<size_t>(K);
+        for (int k = 0; k < K; ++k)
+        {
+            const double d = Tour::edgeCost(pts[i], pts[cand[k]]);
+            const double eta = 1.0 / (1.0 + d); // heuristic
+            m_cand[row + k].to = cand[k];
+            m_etaPow[row + k] = std::pow(eta, m_beta);
+        }
     }
 
-    // reset iteration state
-    m_antIndex = 0;
-    m_iterBestCost = std::numeric_limits<double>::infinity();
-    m_iterBestOrder.clear();
+    buildEdgeSlots();
+    updateChoiceInfo();
 }
 
-int AcoOptimizer::pickRandomUnvisited(const std::vector<char>& visited)
+static inline uint64_t edgeKey(int a, int b)
 {
-    std::uniform_int_distribution<int> pick(0, m_n - 1);
-    for (int tries = 0; tries < 1024; ++tries)
+    return (static_cast<uint64_t>(static_cast<uint32_t>(a)) << 32) | static_cast<uint32_t>(b);
+}
+
+static inline uint64_t edgeHash(uint64_t key)
+{
+    return key * 0x9E3779B97F4A7C15ull;
+}
+
+void AcoOptimizer::buildEdgeSlots()
+{
+    // load factor <= 0.5
+    uint64_t cap = 16;
+    while (cap < 2 * static_cast<uint64_t>(m_cand.size())) cap <<= 1;
+    m_slotMask = cap - 1;
+    m_slotKeys.assign(cap, ~0ull);
+    m_slotIndex.assign(cap, -1);
+
+    for (int i = 0; i < m_n; ++i)
     {
-        const int j = pick(m_rng);
-        if (!visited[j]) return j;
+        for (int k = 0; k < m_K; ++k)
+        {
+            const int slot = i * m_K + k;
+            const uint64_t key = edgeKey(i, m_cand[slot].to);
+            uint64_t h = (edgeHash(key) >> 20) & m_slotMask;
+            while (m_slotKeys[h] != ~0ull && m_slotKeys[h] != key)
+                h = (h + 1) & m_slotMask;
+            m_slotKeys[h] = key;
+            m_slotIndex[h] = slot;
+        }
     }
-    // fallback linear
-    for (int j = 0; j < m_n; ++j)
-        if (!visited[j]) return j;
-    return 0;
 }
 
-int AcoOptimizer::chooseNext(int current, const std::vector<char>& visited)
+int AcoOptimizer::edgeSlot(int a, int b) const
 {
-    const auto& pts = m_instance->points();
+    const uint64_t key = edgeKey(a, b);
+    uint64_t h = (edgeHash(key) >> 20) & m_slotMask;
+    for (;;)
+    {
+        const uint64_t k = m_slotKeys[h];
+        if (k == key) return m_slotIndex[h];
+        if (k == ~0ull) return -1;
+        h = (h + 1) & m_slotMask;
+    }
+}
 
-    const auto& cand = m_candidates[current];
-    const auto& tau  = m_tau[current];
+void AcoOptimizer::updateChoiceInfo()
+{
+    const size_t total = m_cand.size();
+    const double* tau = m_tau.data();
+    const double* eta = m_etaPow.data();
+    Candidate* cand = m_cand.data();
 
-    // Compute desirabilities for unvisited candidates
-    std::vector<double> w;
-    w.resize(cand.size(), 0.0);
+    if (m_alpha == 1.0)
+    {
+        for (size_t s = 0; s < total; ++s)
+            cand[s].choice = std::max(1e-12, tau[s]) * eta[s];
+    }
+    else
+    {
+        for (size_t s = 0; s < total; ++s)
+            cand[s].choice = std::pow(std::max(1e-12, tau[s]), m_alpha) * eta[s];
+    }
+}
 
-    double sumW = 0.0;
-    for (size_t k = 0; k < cand.size(); ++k)
+void AcoOptimizer::visit(Ant& ant, int city) const
+{
+    ant.visited[city] = 1;
+
+    // swap-remove from the unvisited set
+    const int p = ant.unvisitedPos[city];
+    const int last = ant.unvisited.back();
+    ant.unvisited[p] = last;
+    ant.unvisitedPos[last] = p;
+    ant.unvisited.pop_back();
+}
+
+int AcoOptimizer::nearestUnvisited(int current, const Ant& ant) const
+{
+    // Only reached when every candidate of `current` is visited. The ring search finds a
+    // near free city in O(1) cells; it gives up once it has looked at as many cells as
+    // cities remain, and the scan of the remaining set takes over. A lookup costs
+    // O(min(cells to the answer, remaining)), so it never exceeds the plain scan.
+    const int remaining = static_cast<int>(ant.unvisited.size());
+    const int j = m_grid->nearestUnmarked(current, ant.visited.data(), remaining);
+    if (j >= 0)
+        return j;
+
+    const auto& pts = m_instance->points();
+    int best = ant.unvisited.front();
+    double bestD = Tour::edgeCost(pts[current], pts[best]);
+    for (int t = 1; t < remaining; ++t)
     {
-        const int j = cand[k];
-        if (visited[j]) continue;
+        const int c = ant.unvisited[t];
+        const double d = Tour::edgeCost(pts[current], pts[c]);
+        if (d < bestD)
+        {
+            bestD = d;
+            best = c;
+        }
+    }
+    return best;
+}
 
-        const double d = Tour::edgeCost(pts[current], pts[j]);
-        const double eta = 1.0 / (1.0 + d); // heuristic
+int AcoOptimizer::chooseNext(int current, Ant& ant) const
+{
+    const Candidate* cand = m_cand.data() + static_cast<size_t>(current) * static_cast<size_t>(m_K);
+    const char* visited = ant.visited.data();
+    double* w = ant.weights.data();
+    const int K = m_K;
 
-        const double t = std::max(1e-12, tau[k]);
-        const double val = std::pow(t, m_alpha) * std::pow(eta, m_beta);
-        w[k] = val;
-        sumW += val;
+    // masked weights + running total; branch-free so the compiler can vectorize the
+    // arithmetic (the visited[] gather is the only indirect access)
+    double sumW = 0.0;
+    for (int k = 0; k < K; ++k)
+    {
+        const double mask = visited[cand[k].to] ? 0.0 : 1.0;
+        sumW += cand[k].choice * mask;
+        w[k] = sumW;
     }
 
     if (sumW <= 0.0)
-        return pickRandomUnvisited(visited);
+        return nearestUnvisited(current, ant);
 
     std::uniform_real_distribution<double> uni01(0.0, 1.0);
-    const double r = uni01(m_rng) * sumW;
+    const double r = uni01(ant.rng) * sumW;
+
+    // first cumulative weight >= r (masked entries never satisfy it on their own:
+    // they repeat the previous total, which is < r or was already picked)
+    int k = 0;
+    while (k < K - 1 && w[k] < r) ++k;
 
-    double acc = 0.0;
-    for (size_t k = 0; k < cand.size(); ++k)
+    if (visited[cand[k].to])
     {
-        if (w[k] <= 0.0) continue;
-        acc += w[k];
-        if (acc >= r)
-            return cand[k];
+        // numeric fallback: last unvisited candidate
+        for (k = K - 1; k >= 0 && visited[cand[k].to]; --k) {}
     }
-
-    // numeric fallback
-    for (size_t k = 0; k < cand.size(); ++k)
-        if (w[k] > 0.0) return cand[k];
-
-    return pickRandomUnvisited(visited);
+    return cand[k].to;
 }
 
-std::vector<int> AcoOptimizer::constructTour()
+bool AcoOptimizer::constructTour(Ant& ant) const
 {
-    std::vector<int> ord;
-    ord.reserve(static_cast<size_t>(m_n));
-
-    std::vector<char> visited(static_cast<size_t>(m_n), 0);
+    auto& ord = ant.order;
+    ord.clear();
+    std::fill(ant.visited.begin(), ant.visited.end(), 0);
+    ant.unvisited.resize(static_cast<size_t>(m_n));
+    for (int c = 0; c < m_n; ++c)
+    {
+        ant.unvisited[c] = c;
+        ant.unvisitedPos[c] = c;
+    }
 
     // Fix node 0 as start (removes symmetry and matches other optimizers' behavior)
     int current = 0;
     ord.push_back(current);
-    visited[current] = 1;
+    visit(ant, current);
 
     for (int step = 1; step < m_n; ++step)
     {
-        const int nxt = chooseNext(current, visited);
+        if ((step & (kCancelCheckSteps - 1)) == 0 && cancelled())
+        {
+            ant.cost = std::numeric_limits<double>::infinity();
+            return false;
+        }
+
+        const int nxt = chooseNext(current, ant);
         ord.push_back(nxt);
-        visited[nxt] = 1;
+        visit(ant, nxt);
         current = nxt;
     }
 
-    return ord;
+    ant.cost = costOf(ord);
+    return true;
 }
 
-bool AcoOptimizer::iterate()
+void AcoOptimizer::buildAnt(Ant& ant)
+{
+    if (!constructTour(ant))
+        return;
+    if (m_localSearch)
+    {
+        TwoOptLocalSearch& ls = *m_searchers[m_pool ? m_pool->workerIndex() : 0];
+        ant.cost += ls.optimize(ant.order.data());
+    }
+}
+
+void AcoOptimizer::updateTrailLimits()
+{
+    // tau_max = Q / (rho * C_best); tau_min follows from the probability p_best that an
+    // ant rebuilds the best tour once the trails have converged (avg = K/2 choices per step).
+    const double rho = std::clamp(m_rho, 1e-6, 1.0);
+    m_tauMax = m_Q / (rho * std::max(1.0, m_lastBest));
+
+    const double pDec = std::pow(kBestTourProbability, 1.0 / static_cast<double>(m_n));
+    const double avg = std::max(2.0, 0.5 * static_cast<double>(m_K));
+    m_tauMin = std::min(m_tauMax, m_tauMax * (1.0 - pDec) / ((avg - 1.0) * pDec));
+}
+
+void AcoOptimizer::resetTrails()
 {
-    if (!m_instance || m_n < 2 || m_candidates.empty() || m_tau.empty())
+    std::fill(m_tau.begin(), m_tau.end(), m_tauMax);
+    updateChoiceInfo();
+    m_sinceReset = 0;
+    m_stagnation = 0;
+}
+
+bool AcoOptimizer::depositGlobalBest() const
+{
+    // the global-best tour deposits more often as the search matures
+    if (m_sinceReset < 25)
         return false;
+    const int every = (m_sinceReset < 75) ? 5 : (m_sinceReset < 125) ? 3 : (m_sinceReset < 250) ? 2 : 1;
+    return m_sinceReset % every == 0;
+}
 
-    bool improved = false;
+void AcoOptimizer::updatePheromones(const std::vector<int>& order, double cost)
+{
+    // evaporation
+    const double evap = (m_rho < 0.0) ? 0.0 : (m_rho > 1.0 ? 1.0 : m_rho);
+    const double keep = 1.0 - evap;
+
+    for (double& t : m_tau)
+        t *= keep;
+
+    // deposit from the best tour of the batch
+    if (order.empty() || !std::isfinite(cost) || cost <= 0.0)
+        return;
 
-    // Build ONE ant tour per iterate() call
-    std::vector<int> ord = constructTour();
-    const double c = costOf(ord);
+    const double delta = m_Q / cost;
 
-    if (c < m_iterBestCost)
+    for (int i = 0; i < m_n - 1; ++i)
     {
-        m_iterBestCost = c;
-        m_iterBestOrder = ord;
+        const int a = order[i];
+        const int b = order[i + 1];
+
+        // both directions if present (helps symmetry)
+        const int ab = edgeSlot(a, b);
+        if (ab >= 0) m_tau[ab] += delta;
+        const int ba = edgeSlot(b, a);
+        if (ba >= 0) m_tau[ba] += delta;
     }
 
-    if (c < m_lastBest)
+    if (m_variant == Variant::MaxMin)
     {
-        m_best = Tour(m_instance, std::move(ord));
-        m_lastBest = m_best.cost();
-        improved = true;
+        for (double& t : m_tau)
+            t = std::clamp(t, m_tauMin, m_tauMax);
     }
+}
 
-    ++m_antIndex;
+bool AcoOptimizer::iterate()
+{
+    if (!m_instance || m_n < 2 || m_cand.empty())
+        return false;
 
-    // After all ants of this "iteration", update pheromones using the iteration-best tour.
-    if (m_antIndex >= m_antsPerIter)
-    {
-        // evaporation
-        const double evap = (m_rho < 0.0) ? 0.0 : (m_rho > 1.0 ? 1.0 : m_rho);
-        const double keep = 1.0 - evap;
+    // Build the whole batch; ants only read the pheromones, so they can run concurrently.
+    if (m_pool)
+        m_pool->parallelFor(0, m_antsPerIter, [this](int a){ buildAnt(m_ants[a]); }, m_threads);
+    else
+        for (auto& ant : m_ants) buildAnt(ant);
 
-        for (int i = 0; i < m_n; ++i)
-            for (double& t : m_tau[i])
-                t *= keep;
+    // a cancelled batch holds unfinished ants
+    if (cancelled())
+        return false;
 
-        // deposit from best tour of the batch
-        if (!m_iterBestOrder.empty() && std::isfinite(m_iterBestCost) && m_iterBestCost > 0.0)
-        {
-            const double delta = m_Q / m_iterBestCost;
+    // Deterministic merge: lowest cost, ties to the lowest ant index.
+    int iterBest = 0;
+    for (int a = 1; a < m_antsPerIter; ++a)
+        if (m_ants[a].cost < m_ants[iterBest].cost) iterBest = a;
 
-            for (int i = 0; i < m_n - 1; ++i)
-            {
-                const int a = m_iterBestOrder[i];
-                const int b = m_iterBestOrder[i + 1];
-
-                // update tau[a][k] where candidates[a][k] == b
-                auto& candA = m_candidates[a];
-                auto& tauA  = m_tau[a];
-                for (size_t k = 0; k < candA.size(); ++k)
-                {
-                    if (candA[k] == b) { tauA[k] += delta; break; }
-                }
-
-                // also update reverse direction if present (helps symmetry)
-                auto& candB = m_candidates[b];
-                auto& tauB  = m_tau[b];
-                for (size_t k = 0; k < candB.size(); ++k)
-                {
-                    if (candB[k] == a) { tauB[k] += delta; break; }
-                }
-            }
+    const Ant& bestAnt = m_ants[iterBest];
+
+    bool improved = false;
+    if (bestAnt.cost < m_lastBest)
+    {
+        m_best.order().assign(bestAnt.order.begin(), bestAnt.order.end());
+        m_best.setCost(bestAnt.cost);
+        m_lastBest = bestAnt.cost;
+        improved = true;
+    }
+
+    if (m_variant == Variant::MaxMin)
+    {
+        if (improved)
+        {
+            updateTrailLimits();
+            m_stagnation = 0;
+        }
+        else if (++m_stagnation >= kStagnationLimit)
+        {
+            resetTrails();
+            return false;
         }
 
-        // reset batch
-        m_antIndex = 0;
-        m_iterBestCost = std::numeric_limits<double>::infinity();
-        m_iterBestOrder.clear();
+        ++m_sinceReset;
+        if (depositGlobalBest())
+            updatePheromones(m_best.order(), m_best.cost());
+        else
+            updatePheromones(bestAnt.order, bestAnt.cost);
+        updateChoiceInfo();
+        return improved;
     }
 
+    // After all ants of this "iteration", update pheromones using the iteration-best tour.
+    updatePheromones(bestAnt.order, bestAnt.cost);
+    updateChoiceInfo();
+
     return improved;
 }
+
+bool AcoOptimizer::iterateBatch(int maxSteps, Clock::time_point deadline)
+{
+    return runBatch(*this, maxSteps, deadline, 1);
+}
+
+bool AcoOptimizer::inject(const std::vector<int>& order, double cost)
+{
+    if (static_cast<int>(order.size()) != m_n || m_cand.empty())
+        return false;
+
+    if (cost < m_lastBest)
+    {
+        m_best.order().assign(order.begin(), order.end());
+        m_best.setCost(cost);
+        m_lastBest = cost;
+        if (m_variant == Variant::MaxMin)
+        {
+            updateTrailLimits();
+            m_stagnation = 0;
+        }
+    }
+
+    // reinforce the outside tour's edges so the next ants sample around it
+    updatePheromones(order, cost);
+    updateChoiceInfo();
+    return true;
+}
+
+void AcoOptimizer::setCancellation(const CancellationToken* token)
+{
+    IOptimizer::setCancellation(token);
+    for (auto& ls : m_searchers)
+        ls->setCancellation(token);
+}
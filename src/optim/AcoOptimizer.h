@@ -1,18 +1,34 @@
 #pragma once
 
 #include "IOptimizer.h"
+#include "LocalSearch.h"
+#include "TaskScheduler.h"
+#include "../SpatialGrid.h"
+#include <memory>
 #include <random>
 #include <vector>
 #include <limits>
+#include <cstdint>
 
 // Ant Colony Optimization (sparse candidate-list variant suitable for large TSP instances).
 // Notes:
 // - Uses a per-node candidate list of size K (approximate nearest neighbors by random sampling).
-// - Maintains pheromone only on candidate edges (N*K storage).
+// - Maintains pheromone only on candidate edges (N*K storage, flat CSR rows of K entries).
 // - Builds open tours (no return edge), consistent with Tour::evaluate().
+// - Each iterate() builds one batch of ants (optionally on the shared TaskScheduler), then updates
+//   the pheromones. Every ant slot owns its RNG stream and visited array, and the batch
+//   is merged in ant order, so results do not depend on the thread count.
+// - MaxMin selects the MAX-MIN Ant System: pheromone is kept within [tau_min, tau_max],
+//   the deposit alternates between the iteration-best and global-best tour on a schedule
+//   that shifts towards the global best, and the trails are re-initialized to tau_max
+//   when the global best stagnates.
+// - localSearch polishes every ant with neighbor-list 2-opt + or-opt (inside the parallel
+//   batch); the candidate lists are then exact K-nearest neighbors from the spatial grid.
 class AcoOptimizer final : public IOptimizer
 {
 public:
+    enum class Variant { AntSystem, MaxMin };
+
     AcoOptimizer(const Tour& initial,
                  int antsPerIteration = 20,
                  int candidateK = 20,
@@ -21,19 +37,48 @@ public:
                  double beta = 3.0,
                  double rho = 0.10,
                  double q = 1.0,
+                 int threads = 1, // 1 = serial, 0 = all cores
+                 Variant variant = Variant::AntSystem,
+                 bool localSearch = false,
                  uint32_t seed = std::random_device{}());
 
     bool iterate() override;
+    bool iterateBatch(int maxSteps, Clock::time_point deadline) override;
+    bool inject(const std::vector<int>& order, double cost) override;
+    void setCancellation(const CancellationToken* token) override;
     const Tour& bestTour() const override { return m_best; }
     double baselineCost() const override { return m_baseline; }
 
 private:
+    struct Ant
+    {
+        std::mt19937 rng;
+        std::vector<char> visited;
+        std::vector<int> unvisited;    // swap-remove set of the cities still to visit
+        std::vector<int> unvisitedPos; // city -> index in unvisited
+        std::vector<int> order;
+        std::vector<double> weights; // roulette scratch, K entries
+        double cost = 0.0;
+    };
+
     void buildCandidateLists();
-    std::vector<int> constructTour();
+    bool constructTour(Ant& ant) const; // false if cancelled partway
+    void buildAnt(Ant& ant);
     double costOf(const std::vector<int>& ord) const;
+    void updatePheromones(const std::vector<int>& order, double cost);
+    void updateChoiceInfo();
+
+    // MAX-MIN helpers
+    void updateTrailLimits();
+    void resetTrails();
+    bool depositGlobalBest() const;
+
+    void buildEdgeSlots();
+    int edgeSlot(int a, int b) const; // index into the CSR arrays, -1 if (a,b) is not a candidate edge
 
-    int pickRandomUnvisited(const std::vector<char>& visited);
-    int chooseNext(int current, const std::vector<char>& visited);
+    void visit(Ant& ant, int city) const;
+    int nearestUnvisited(int current, const Ant& ant) const;
+    int chooseNext(int current, Ant& ant) const;
 
 private:
     const TspInstance* m_instance = nullptr;
@@ -49,16 +94,44 @@ private:
     double m_rho   = 0.10;
     double m_Q     = 1.0;
 
-    // Candidate edges and pheromones: candidates[i][k] with pheromone tau[i][k]
-    std::vector<std::vector<int>>    m_candidates;
-    std::vector<std::vector<double>> m_tau;
+    Variant m_variant = Variant::AntSystem;
+    bool m_localSearch = false;
+
+    // MAX-MIN state
+    double m_tauMin = 0.0;
+    double m_tauMax = 1.0;
+    int m_sinceReset = 0;   // iterations since the trails were (re)initialized
+    int m_stagnation = 0;   // iterations without a new global best
+
+    // Candidate edges in CSR form: row i is [i*K, (i+1)*K).
+    // The construction hot path reads the target and its choice info together, so they
+    // are interleaved; pheromone and eta^beta live in their own flat arrays, so that
+    // evaporation and the choice-info refresh are single passes over contiguous memory.
+    struct Candidate
+    {
+        int to;
+        double choice; // tau^alpha * eta^beta, recomputed once per pheromone update
+    };
+    int m_K = 0;
+    std::vector<Candidate> m_cand;
+    std::vector<double> m_tau;
+    std::vector<double> m_etaPow; // static
+
+    // open-addressing map (a,b) -> CSR slot for O(1) deposits
+    std::vector<uint64_t> m_slotKeys;
+    std::vector<int> m_slotIndex;
+    uint64_t m_slotMask = 0;
 
     std::mt19937 m_rng;
 
-    // Iteration bookkeeping (one ant tour per iterate() call)
-    int m_antIndex = 0;
-    double m_iterBestCost = std::numeric_limits<double>::infinity();
-    std::vector<int> m_iterBestOrder;
+    // One batch of ants per iterate() call
+    std::vector<Ant> m_ants;
+    TaskScheduler* m_pool = nullptr; // shared scheduler; null in serial mode
+    int m_threads = 1;               // threads per parallelFor
+
+    std::unique_ptr<SpatialGrid> m_grid; // nearest-unvisited fallback
+    std::vector<int> m_neighbors; // exact K-nearest lists (local search mode)
+    std::vector<std::unique_ptr<TwoOptLocalSearch>> m_searchers; // one per thread
 
     // Global best
     Tour m_best;
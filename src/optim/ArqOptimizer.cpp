@@ -10,11 +10,13 @@ static inline double clamp01(double x)
     return x;
 }
 
-ArqOptimizer::ArqOptimizer(const Tour& initial, int populationSize, uint32_t seed)
+ArqOptimizer::ArqOptimizer(const Tour& initial, int populationSize, int threads, bool synchronousGenerations,
+                           uint32_t seed)
 : m_instance(initial.instance()),
   m_n(initial.size()),
   m_popSize(std::max(4, populationSize)),
   m_rng(seed),
+  m_synchronous(synchronousGenerations),
   m_best(initial),
   m_baseline(initial.cost()),
   m_lastBest(initial.cost())
@@ -53,6 +55,42 @@ ArqOptimizer::ArqOptimizer(const Tour& initial, int populationSize, uint32_t see
         }
     }
 
+    m_trial.resize(static_cast<size_t>(m_n));
+
+    if (m_synchronous)
+    {
+        if (threads != 1)
+        {
+            m_pool = &TaskScheduler::instance();
+            m_threads = (threads > 0) ? std::min(threads, m_pool->size()) : m_pool->size();
+        }
+
+        m_slotRng.reserve(static_cast<size_t>(m_popSize));
+        for (int i = 0; i < m_popSize; ++i)
+        {
+            std::seed_seq seq{ seed, static_cast<uint32_t>(i) };
+            m_slotRng.emplace_back(seq);
+        }
+        m_trials.assign(static_cast<size_t>(m_popSize), std::vector<int>(static_cast<size_t>(m_n)));
+        m_trialF.resize(static_cast<size_t>(m_popSize));
+        m_trialCR.resize(static_cast<size_t>(m_popSize));
+        m_trialCost.resize(static_cast<size_t>(m_popSize));
+    }
+
+    m_scratch.resize(m_pool ? static_cast<size_t>(m_pool->size()) : 1);
+    for (Scratch& sc : m_scratch)
+    {
+        sc.pos.resize(static_cast<size_t>(m_n));
+        sc.diff.reserve(static_cast<size_t>(m_n));
+        sc.stamp.assign(static_cast<size_t>(m_n), 0);
+    }
+
+    const int archiveCap = std::max(1, static_cast<int>(std::round(m_archiveRate * m_popSize)));
+    m_archive.resize(static_cast<size_t>(archiveCap)); // slot buffers are filled by the first pushes
+    m_SF.reserve(static_cast<size_t>(m_popSize));
+    m_SCR.reserve(static_cast<size_t>(m_popSize));
+    m_SG.reserve(static_cast<size_t>(m_popSize));
+
     beginGeneration();
 }
 
@@ -87,31 +125,31 @@ void ArqOptimizer::randomizeOrder(std::vector<int>& ord, int swaps)
     }
 }
 
-int ArqOptimizer::pickDistinctIndex(int avoid1, int avoid2)
+int ArqOptimizer::pickDistinctIndex(std::mt19937& rng, int avoid1, int avoid2) const
 {
     std::uniform_int_distribution<int> dist(0, m_popSize - 1);
     int r = 0;
     do {
-        r = dist(m_rng);
+        r = dist(rng);
     } while (r == avoid1 || r == avoid2);
     return r;
 }
 
-int ArqOptimizer::pickPBestIndex()
+int ArqOptimizer::pickPBestIndex(std::mt19937& rng) const
 {
     const int P = std::max(2, static_cast<int>(std::ceil(m_pbest * m_popSize)));
     std::uniform_int_distribution<int> dist(0, P - 1);
-    return m_rank[dist(m_rng)];
+    return m_rank[dist(rng)];
 }
 
-double ArqOptimizer::sampleF()
+double ArqOptimizer::sampleF(std::mt19937& rng) const
 {
     // cauchy around muF (like JADE); resample until in [Flo, Fhi]
     std::cauchy_distribution<double> cauchy(m_muF, 0.10);
     double F = 0.0;
     for (int tries = 0; tries < 32; ++tries)
     {
-        F = cauchy(m_rng);
+        F = cauchy(rng);
         if (std::isfinite(F) && F >= m_Flo && F <= m_Fhi)
             break;
     }
@@ -121,40 +159,51 @@ double ArqOptimizer::sampleF()
     return F;
 }
 
-double ArqOptimizer::sampleCR()
+double ArqOptimizer::sampleCR(std::mt19937& rng) const
 {
     std::normal_distribution<double> norm(m_muCR, 0.10);
-    double CR = norm(m_rng);
+    double CR = norm(rng);
     if (!std::isfinite(CR)) CR = m_muCR;
     return clamp01(CR);
 }
 
-std::vector<int> ArqOptimizer::orderCrossover(const std::vector<int>& a, const std::vector<int>& b, double CR)
+void ArqOptimizer::orderCrossover(const std::vector<int>& a, const std::vector<int>& b, double CR, std::vector<int>& child,
+                                  Scratch& scratch, std::mt19937& rng) const
 {
     // OX-like crossover that keeps 0 fixed at position 0 and operates on positions [1..n-1].
     // Segment length roughly CR*(n-1), but capped for very large n to keep the step lightweight.
     const int n = m_n;
-    if (n < 4) return a;
+    if (n < 4)
+    {
+        child.assign(a.begin(), a.end());
+        return;
+    }
 
     const int maxSeg = std::min(n - 1, 800); // cap to avoid huge copy on large n
     int segLen = static_cast<int>(std::round(CR * static_cast<double>(n - 1)));
-    segLen = std::max(10, std::min(maxSeg, segLen));
+    segLen = std::clamp(segLen, std::min(10, maxSeg), maxSeg); // at least 10, or all of a small tour
 
     std::uniform_int_distribution<int> startDist(1, (n - 1) - segLen + 1);
-    const int start = startDist(m_rng);
+    const int start = startDist(rng);
     const int end = start + segLen - 1;
 
-    std::vector<int> child(n, -1);
+    std::fill(child.begin(), child.end(), -1);
     child[0] = 0;
 
-    std::vector<char> used(static_cast<size_t>(n), 0);
-    used[0] = 1;
+    if (++scratch.epoch == 0)
+    {
+        std::fill(scratch.stamp.begin(), scratch.stamp.end(), 0);
+        scratch.epoch = 1;
+    }
+    int* used = scratch.stamp.data();
+    const int epoch = scratch.epoch;
+    used[0] = epoch;
 
     // copy segment from b
     for (int i = start; i <= end; ++i)
     {
         child[i] = b[i];
-        used[static_cast<size_t>(b[i])] = 1;
+        used[b[i]] = epoch;
     }
 
     // fill remaining positions from a in order (OX wrap-around)
@@ -164,7 +213,7 @@ std::vector<int> ArqOptimizer::orderCrossover(const std::vector<int>& a, const s
     for (int i = 1; i < n; ++i)
     {
         const int v = a[i];
-        if (used[static_cast<size_t>(v)]) continue;
+        if (used[v] == epoch) continue;
 
         // skip the protected segment
         while (writePos >= start && writePos <= end)
@@ -174,7 +223,7 @@ std::vector<int> ArqOptimizer::orderCrossover(const std::vector<int>& a, const s
         }
 
         child[writePos] = v;
-        used[static_cast<size_t>(v)] = 1;
+        used[v] = epoch;
 
         ++writePos;
         if (writePos >= n) writePos = 1;
@@ -186,19 +235,18 @@ std::vector<int> ArqOptimizer::orderCrossover(const std::vector<int>& a, const s
         if (child[i] != -1) continue;
         for (int v = 1; v < n; ++v)
         {
-            if (!used[static_cast<size_t>(v)])
+            if (used[v] != epoch)
             {
                 child[i] = v;
-                used[static_cast<size_t>(v)] = 1;
+                used[v] = epoch;
                 break;
             }
         }
     }
-
-    return child;
 }
 
-void ArqOptimizer::applyDifferenceToward(std::vector<int>& trial, const std::vector<int>& donor, double F)
+void ArqOptimizer::applyDifferenceToward(std::vector<int>& trial, const std::vector<int>& donor, double F,
+                                         Scratch& scratch, std::mt19937& rng) const
 {
     // Move a subset of donor positions into the trial by swaps (keeps permutation valid).
     // F controls how many positions are enforced.
@@ -209,13 +257,13 @@ void ArqOptimizer::applyDifferenceToward(std::vector<int>& trial, const std::vec
     const double strength = clamp01(F / m_Fhi);
 
     // Build position map for trial
-    std::vector<int> pos(static_cast<size_t>(n), -1);
+    std::vector<int>& pos = scratch.pos;
     for (int i = 0; i < n; ++i)
         pos[static_cast<size_t>(trial[i])] = i;
 
     // collect differing positions (excluding 0)
-    std::vector<int> diff;
-    diff.reserve(static_cast<size_t>(n / 2));
+    std::vector<int>& diff = scratch.diff;
+    diff.clear();
     for (int i = 1; i < n; ++i)
         if (trial[i] != donor[i]) diff.push_back(i);
 
@@ -224,7 +272,7 @@ void ArqOptimizer::applyDifferenceToward(std::vector<int>& trial, const std::vec
     int m = static_cast<int>(std::round(strength * static_cast<double>(diff.size())));
     m = std::max(1, std::min(static_cast<int>(diff.size()), std::min(600, m))); // cap effort
 
-    std::shuffle(diff.begin(), diff.end(), m_rng);
+    std::shuffle(diff.begin(), diff.end(), rng);
 
     for (int t = 0; t < m; ++t)
     {
@@ -240,14 +288,14 @@ void ArqOptimizer::applyDifferenceToward(std::vector<int>& trial, const std::vec
     }
 }
 
-void ArqOptimizer::smallPerturbation(std::vector<int>& ord)
+void ArqOptimizer::smallPerturbation(std::vector<int>& ord, std::mt19937& rng) const
 {
     // occasional 2-opt-like reversal on a small segment (excluding position 0)
     if (m_n < 6) return;
 
     std::uniform_int_distribution<int> dist(1, m_n - 1);
-    int a = dist(m_rng);
-    int b = dist(m_rng);
+    int a = dist(rng);
+    int b = dist(rng);
     if (a == b) return;
     if (a > b) std::swap(a, b);
     if (b - a < 3) return;
@@ -255,19 +303,14 @@ void ArqOptimizer::smallPerturbation(std::vector<int>& ord)
     std::reverse(ord.begin() + a, ord.begin() + b + 1);
 }
 
-void ArqOptimizer::archivePush(const std::vector<int>& ord)
-{
-    m_archive.push_back(ord);
-}
-
-void ArqOptimizer::archiveTrim()
+void ArqOptimizer::archivePush(std::vector<int>& ord)
 {
-    const int cap = std::max(1, static_cast<int>(std::round(m_archiveRate * m_popSize)));
-    if (static_cast<int>(m_archive.size()) <= cap) return;
-
-    // keep the most recent cap entries
-    const int start = static_cast<int>(m_archive.size()) - cap;
-    m_archive.erase(m_archive.begin(), m_archive.begin() + start);
+    // the oldest entry is evicted once the ring is full
+    m_archive[m_archiveHead].swap(ord);
+    if (++m_archiveHead == static_cast<int>(m_archive.size()))
+        m_archiveHead = 0;
+    if (m_archiveSize < static_cast<int>(m_archive.size()))
+        ++m_archiveSize;
 }
 
 void ArqOptimizer::beginGeneration()
@@ -331,8 +374,6 @@ void ArqOptimizer::endGeneration()
             m_bestPrev = m_lastBest;
         }
     }
-
-    archiveTrim();
 }
 
 void ArqOptimizer::restartWorst()
@@ -344,12 +385,13 @@ void ArqOptimizer::restartWorst()
     if (m_rank.empty())
         beginGeneration();
 
-    const std::vector<int> bestOrd = m_pop[m_rank[0]];
+    const std::vector<int>& bestOrd = m_pop[m_rank[0]];
 
     for (int k = 0; k < W; ++k)
     {
         const int idx = m_rank[m_popSize - 1 - k];
-        std::vector<int> ord = bestOrd;
+        std::vector<int>& ord = m_pop[idx];
+        ord.assign(bestOrd.begin(), bestOrd.end());
 
         // rsigma controls swaps, capped to keep step reasonable
         int swaps = static_cast<int>(std::round(m_rsigma * static_cast<double>(m_n)));
@@ -357,90 +399,135 @@ void ArqOptimizer::restartWorst()
         randomizeOrder(ord, swaps);
 
         const double c = costOf(ord);
-        m_pop[idx] = std::move(ord);
         m_cost[idx] = c;
 
         if (c < m_lastBest)
         {
-            m_best = Tour(m_instance, m_pop[idx]);
+            m_best.order().assign(ord.begin(), ord.end());
+            m_best.setCost(c);
             m_lastBest = c;
         }
     }
 }
 
-bool ArqOptimizer::iterate()
+double ArqOptimizer::makeTrial(int i, std::vector<int>& trial, double& F, double& CR,
+                               Scratch& scratch, std::mt19937& rng) const
 {
-    if (!m_instance || m_n < 2 || m_pop.empty())
-        return false;
-
-    bool improved = false;
-
-    // generation boundary bookkeeping
-    if (m_target == 0)
-        beginGeneration();
-
-    const int i = m_target;
-
     // select guidance and donors
-    const int pbestIdx = pickPBestIndex();
-    const int r1 = pickDistinctIndex(i, pbestIdx);
+    const int pbestIdx = pickPBestIndex(rng);
+    const int r1 = pickDistinctIndex(rng, i, pbestIdx);
 
     // r2 can be from archive with some probability
-    const bool useArchive = (!m_archive.empty() && (std::uniform_real_distribution<double>(0.0,1.0)(m_rng) < 0.35));
+    const bool useArchive = (m_archiveSize > 0 && (std::uniform_real_distribution<double>(0.0,1.0)(rng) < 0.35));
 
     const std::vector<int>& parent = m_pop[i];
     const std::vector<int>& pbest  = m_pop[pbestIdx];
-    const std::vector<int>& donor1 = m_pop[r1];
 
-    std::vector<int> donor2;
+    // donors are referenced in place
+    const std::vector<int>* donor2 = nullptr;
     if (useArchive)
     {
-        std::uniform_int_distribution<int> d(0, static_cast<int>(m_archive.size()) - 1);
-        donor2 = m_archive[d(m_rng)];
+        std::uniform_int_distribution<int> d(0, m_archiveSize - 1);
+        donor2 = &m_archive[d(rng)];
     }
     else
     {
-        const int r2 = pickDistinctIndex(i, r1);
-        donor2 = m_pop[r2];
+        const int r2 = pickDistinctIndex(rng, i, r1);
+        donor2 = &m_pop[r2];
     }
 
     // sample control parameters
-    const double F  = sampleF();
-    const double CR = sampleCR();
+    F  = sampleF(rng);
+    CR = sampleCR(rng);
 
     // trial generation (permutation "DE-like")
-    std::vector<int> trial = orderCrossover(parent, pbest, CR);
+    orderCrossover(parent, pbest, CR, trial, scratch, rng);
 
     // push trial toward donor2 using difference operations weighted by F
-    applyDifferenceToward(trial, donor2, F);
+    applyDifferenceToward(trial, *donor2, F, scratch, rng);
 
     // occasional small perturbation to escape local traps
-    if (std::uniform_real_distribution<double>(0.0,1.0)(m_rng) < 0.10)
-        smallPerturbation(trial);
+    if (std::uniform_real_distribution<double>(0.0,1.0)(rng) < 0.10)
+        smallPerturbation(trial, rng);
+
+    return costOf(trial);
+}
 
-    // evaluate and select
+bool ArqOptimizer::acceptTrial(int i, std::vector<int>& trial, double cost, double F, double CR)
+{
     const double f_parent = m_cost[i];
-    const double f_trial  = costOf(trial);
+    if (!(cost < f_parent))
+        return false;
+
+    // the parent's buffer goes to the archive, the trial's becomes the parent, and the
+    // evicted archive buffer becomes the next trial (empty only while the ring fills up)
+    archivePush(m_pop[i]);
+    m_pop[i].swap(trial);
+    trial.resize(static_cast<size_t>(m_n));
+    m_cost[i] = cost;
+
+    // record success
+    m_SF.push_back(F);
+    m_SCR.push_back(CR);
+    m_SG.push_back(f_parent - cost);
 
-    if (f_trial < f_parent)
+    if (cost < m_lastBest)
     {
-        archivePush(parent);
+        m_best.order().assign(m_pop[i].begin(), m_pop[i].end());
+        m_best.setCost(cost);
+        m_lastBest = cost;
+        return true;
+    }
+    return false;
+}
 
-        m_pop[i] = std::move(trial);
-        m_cost[i] = f_trial;
+bool ArqOptimizer::iterateGeneration()
+{
+    beginGeneration();
 
-        // record success
-        m_SF.push_back(F);
-        m_SCR.push_back(CR);
-        m_SG.push_back(f_parent - f_trial);
+    // All trials see the same population and archive, so they can be built concurrently.
+    auto build = [this](int i)
+    {
+        if (cancelled())
+            return;
+        Scratch& scratch = m_scratch[m_pool ? m_pool->workerIndex() : 0];
+        m_trialCost[i] = makeTrial(i, m_trials[i], m_trialF[i], m_trialCR[i], scratch, m_slotRng[i]);
+    };
+    if (m_pool)
+        m_pool->parallelFor(0, m_popSize, build, m_threads);
+    else
+        for (int i = 0; i < m_popSize; ++i) build(i);
 
-        if (f_trial < m_lastBest)
-        {
-            m_best = Tour(m_instance, m_pop[i]);
-            m_lastBest = f_trial;
-            improved = true;
-        }
-    }
+    // a cancelled generation holds unfinished trials
+    if (cancelled())
+        return false;
+
+    // selection in slot order
+    bool improved = false;
+    for (int i = 0; i < m_popSize; ++i)
+        improved |= acceptTrial(i, m_trials[i], m_trialCost[i], m_trialF[i], m_trialCR[i]);
+
+    endGeneration();
+    return improved;
+}
+
+bool ArqOptimizer::iterate()
+{
+    if (!m_instance || m_n < 2 || m_pop.empty())
+        return false;
+
+    if (m_synchronous)
+        return iterateGeneration();
+
+    // generation boundary bookkeeping
+    if (m_target == 0)
+        beginGeneration();
+
+    const int i = m_target;
+
+    double F = 0.0, CR = 0.0;
+    const double f_trial = makeTrial(i, m_trial, F, CR, m_scratch[0], m_rng);
+    const bool improved = acceptTrial(i, m_trial, f_trial, F, CR);
 
     // advance target
     m_target++;
@@ -452,3 +539,31 @@ bool ArqOptimizer::iterate()
 
     return improved;
 }
+
+bool ArqOptimizer::iterateBatch(int maxSteps, Clock::time_point deadline)
+{
+    // a synchronous step is a whole generation, an asynchronous one a single trial
+    return runBatch(*this, maxSteps, deadline, m_synchronous ? 1 : 8);
+}
+
+bool ArqOptimizer::inject(const std::vector<int>& order, double cost)
+{
+    if (static_cast<int>(order.size()) != m_n || m_pop.empty())
+        return false;
+
+    // the outside tour replaces the worst member
+    const int worst = static_cast<int>(std::max_element(m_cost.begin(), m_cost.end()) - m_cost.begin());
+    if (cost < m_cost[worst])
+    {
+        m_pop[worst].assign(order.begin(), order.end());
+        m_cost[worst] = cost;
+    }
+
+    if (cost < m_lastBest)
+    {
+        m_best.order().assign(order.begin(), order.end());
+        m_best.setCost(cost);
+        m_lastBest = cost;
+    }
+    return true;
+}
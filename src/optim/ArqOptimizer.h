@@ -1,6 +1,8 @@
 #pragma once
 
 #include "IOptimizer.h"
+#include "TaskScheduler.h"
+#include <memory>
 #include <random>
 #include <vector>
 #include <limits>
@@ -13,39 +15,67 @@
 // - adaptive parameters (muF, muCR) similar to JADE/L-SHADE
 // - archive of replaced solutions
 // - stagnation-triggered restart of the worst fraction
+//
+// Two schedules:
+// - asynchronous (default): one target per iterate(); a successful trial replaces its
+//   parent immediately and is visible to the next target.
+// - synchronous generations: iterate() builds and evaluates all popSize trials against the
+//   same population (in parallel on the shared TaskScheduler), then runs selection, archive update and
+//   parameter adaptation once, in slot order. Every slot owns its RNG stream, so the result
+//   does not depend on the thread count.
 class ArqOptimizer final : public IOptimizer
 {
 public:
     ArqOptimizer(const Tour& initial,
                  int populationSize = 30,
+                 int threads = 1, // synchronous mode: 1 = serial, 0 = all cores
+                 bool synchronousGenerations = false,
                  uint32_t seed = std::random_device{}());
 
     bool iterate() override;
+    bool iterateBatch(int maxSteps, Clock::time_point deadline) override;
+    bool inject(const std::vector<int>& order, double cost) override;
     const Tour& bestTour() const override { return m_best; }
     double baselineCost() const override { return m_baseline; }
 
 private:
+    // per-thread operator scratch
+    struct Scratch
+    {
+        std::vector<int> pos;   // node -> position in the trial
+        std::vector<int> diff;  // positions where the trial differs from the donor
+        std::vector<int> stamp; // epoch-stamped "used" markers for the crossover
+        int epoch = 0;
+    };
+
     double costOf(const std::vector<int>& ord) const;
 
     std::vector<int> randomTourOrder();
     void randomizeOrder(std::vector<int>& ord, int swaps);
 
     // permutation operators
-    std::vector<int> orderCrossover(const std::vector<int>& a, const std::vector<int>& b, double CR);
-    void applyDifferenceToward(std::vector<int>& trial, const std::vector<int>& donor, double F);
-    void smallPerturbation(std::vector<int>& ord);
+    void orderCrossover(const std::vector<int>& a, const std::vector<int>& b, double CR, std::vector<int>& child,
+                        Scratch& scratch, std::mt19937& rng) const;
+    void applyDifferenceToward(std::vector<int>& trial, const std::vector<int>& donor, double F,
+                               Scratch& scratch, std::mt19937& rng) const;
+    void smallPerturbation(std::vector<int>& ord, std::mt19937& rng) const;
+
+    // trial for target i from the current population; returns its cost
+    double makeTrial(int i, std::vector<int>& trial, double& F, double& CR, Scratch& scratch, std::mt19937& rng) const;
+    // selection: replaces parent i if the trial is better; returns true on a new global best
+    bool acceptTrial(int i, std::vector<int>& trial, double cost, double F, double CR);
+    bool iterateGeneration();
 
     // policy / adaptation
     void beginGeneration();
     void endGeneration();
-    double sampleF();
-    double sampleCR();
+    double sampleF(std::mt19937& rng) const;
+    double sampleCR(std::mt19937& rng) const;
 
-    int pickDistinctIndex(int avoid1, int avoid2 = -1);
-    int pickPBestIndex();
+    int pickDistinctIndex(std::mt19937& rng, int avoid1, int avoid2 = -1) const;
+    int pickPBestIndex(std::mt19937& rng) const;
 
-    void archivePush(const std::vector<int>& ord);
-    void archiveTrim();
+    void archivePush(std::vector<int>& ord); // swaps ord into the ring; ord receives the evicted buffer
 
     void restartWorst();
 
@@ -78,7 +108,25 @@ private:
 
     std::vector<int> m_rank; // indices sorted by cost ascending (updated each generation)
 
-    std::vector<std::vector<int>> m_archive;
+    // Fixed-capacity ring of permutation buffers. Pushing swaps the parent's buffer into the
+    // oldest slot, so push and eviction are O(1) and the buffers are recycled as trials.
+    std::vector<std::vector<int>> m_archive; // capacity slots, the first m_archiveSize are live
+    int m_archiveSize = 0;
+    int m_archiveHead = 0; // next slot to overwrite
+
+    // per-iteration scratch (sized once, so a warmed-up iterate() does not allocate)
+    std::vector<int> m_trial;
+    std::vector<Scratch> m_scratch; // one per thread
+
+    // synchronous generations
+    bool m_synchronous = false;
+    TaskScheduler* m_pool = nullptr; // shared scheduler; null in serial mode
+    int m_threads = 1;               // threads per parallelFor
+    std::vector<std::mt19937> m_slotRng; // trial RNG stream per slot
+    std::vector<std::vector<int>> m_trials;
+    std::vector<double> m_trialF;
+    std::vector<double> m_trialCR;
+    std::vector<double> m_trialCost;
 
     // asynchronous stepping (one target per iterate())
     int m_target = 0;
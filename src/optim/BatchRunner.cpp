@@ -0,0 +1,231 @@
+#include "BatchRunner.h"
+
+#include "../TspInstance.h"
+#include "TaskScheduler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+// the parameter every parallel preset sizes its thread use with; small instances get 1
+static const char* const kThreadParam = "threads";
+
+namespace
+{
+    // true if a small instance stays on its slot's thread: the preset is serial or runs
+    // with threads=1 (the default the small path sets)
+    bool confinedToSlot(const OptimizerPreset& preset, const OptimizerParams& params)
+    {
+        return !presetReads(preset, kThreadParam) || params.getInt(kThreadParam, 1) == 1;
+    }
+}
+
+BatchRunner::BatchRunner(Options options)
+: m_options(std::move(options))
+{
+}
+
+BatchRunner::Summary BatchRunner::run(const std::vector<std::string>& instances,
+                                      const CancellationToken* cancel,
+                                      const std::function<void(const RunRecord&)>& onRecord)
+{
+    const OptimizerPreset* preset = findPreset(m_options.spec.method);
+    if (!preset)
+        throw std::invalid_argument("unknown method: " + m_options.spec.method);
+
+    // fail before the first instance rather than on every one of them
+    for (const std::string& key : m_options.spec.params.unused())
+    {
+        if (!presetReads(*preset, key))
+            throw std::invalid_argument("parameter " + key + " is not used by method " + m_options.spec.method);
+    }
+
+    // CPU time is only measured per run on the slot's own thread; parallel runs side by
+    // side would share the process clock
+    TaskScheduler& pool = TaskScheduler::instance();
+    const int maxSlots = m_options.slots > 0 ? std::min(m_options.slots, pool.size()) : pool.size();
+    if (m_options.spec.criteria.cpuSeconds > 0.0 && maxSlots > 1 && !confinedToSlot(*preset, m_options.spec.params))
+        throw std::invalid_argument("a CPU limit with several slots needs threads=1");
+
+    m_onRecord = onRecord;
+    m_summary = Summary();
+    m_writeError.clear();
+
+    if (!std::ofstream(m_options.resultsFile, std::ios::app).is_open())
+        throw std::runtime_error("Could not write the results file: " + m_options.resultsFile);
+
+    const std::set<std::string> solved = readSolvedInstances(m_options.resultsFile);
+
+    // size every instance up front; the ones that do not load fail right here
+    std::vector<Job> small;
+    std::vector<Job> large;
+    for (const std::string& file : instances)
+    {
+        if (solved.count(file))
+        {
+            ++m_summary.skipped;
+            continue;
+        }
+
+        try
+        {
+            const int cities = TspInstance::loadFromTspFile(file).size();
+            (cities >= m_options.largeCities ? large : small).push_back({ file, cities });
+        }
+        catch (const std::exception& ex)
+        {
+            RunRecord record;
+            record.instance = file;
+            record.method = m_options.spec.method;
+            record.error = ex.what();
+            write(record);
+        }
+    }
+
+    // small instances side by side, one per slot; the slots are tasks on the shared
+    // scheduler, so they never outnumber its threads
+    const int slots = std::min(maxSlots, static_cast<int>(small.size()));
+
+    std::atomic<size_t> next { 0 };
+    auto slotLoop = [&]{
+        for (;;)
+        {
+            const size_t i = next.fetch_add(1, std::memory_order_relaxed);
+            if (i >= small.size() || (cancel && cancel->cancelled()))
+                return;
+            solve(small[i], false, cancel);
+        }
+    };
+
+    // the calling thread takes one slot
+    TaskGroup group(pool);
+    for (int s = 1; s < slots; ++s)
+        group.run(slotLoop);
+    if (slots > 0)
+        slotLoop();
+    group.wait();
+
+    // then the large ones, each with the whole machine
+    for (const Job& job : large)
+    {
+        if (cancel && cancel->cancelled())
+            break;
+        solve(job, true, cancel);
+    }
+
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    if (!m_writeError.empty())
+        throw std::runtime_error(m_writeError);
+    return m_summary;
+}
+
+void BatchRunner::solve(const Job& job, bool large, const CancellationToken* cancel)
+{
+    SolveSpec spec = m_options.spec;
+    spec.instanceFile = job.file;
+
+    if (!large)
+    {
+        const OptimizerPreset& preset = *findPreset(spec.method);
+        if (presetReads(preset, kThreadParam) && !spec.params.has(kThreadParam))
+            spec.params.set(kThreadParam, "1");
+
+        // other slots run in the same process: count this thread's CPU time only
+        if (confinedToSlot(preset, spec.params))
+            spec.criteria.cpuClock = TerminationCriteria::CpuClock::Thread;
+    }
+
+    if (!m_options.tourDir.empty())
+        spec.tourFile = (fs::path(m_options.tourDir) / fs::path(job.file).stem()).generic_string() + ".tour";
+
+    RunRecord record;
+    try
+    {
+        record = solveInstance(spec, cancel);
+    }
+    catch (const std::exception& ex)
+    {
+        record = RunRecord();
+        record.instance = job.file;
+        record.method = spec.method;
+        record.error = ex.what();
+    }
+
+    if (record.error.empty() && record.result.reason == TerminationReason::Cancelled)
+    {
+        // not finished; resuming the batch runs it again
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        ++m_summary.interrupted;
+        return;
+    }
+
+    write(record);
+}
+
+void BatchRunner::write(const RunRecord& record)
+{
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+
+    // one line per record, flushed right away: a crash loses at most the line in flight
+    std::ofstream out(m_options.resultsFile, std::ios::app);
+    out << toJsonLine(record) << '\n';
+    out.flush();
+    if (!out)
+    {
+        // slot threads cannot throw; run() reports it
+        if (m_writeError.empty())
+            m_writeError = "Could not write the results file: " + m_options.resultsFile;
+        return;
+    }
+
+    if (record.error.empty())
+        ++m_summary.solved;
+    else
+        ++m_summary.failed;
+
+    if (m_onRecord)
+        m_onRecord(record);
+}
+
+std::vector<std::string> listInstances(const std::string& directoryOrManifest)
+{
+    const fs::path source(directoryOrManifest);
+    std::vector<std::string> files;
+
+    if (fs::is_directory(source))
+    {
+        for (const fs::directory_entry& entry : fs::directory_iterator(source))
+        {
+            std::string ext = entry.path().extension().string();
+            std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c){ return static_cast<char>(std::tolower(c)); });
+            if (entry.is_regular_file() && ext == ".tsp")
+                files.push_back(entry.path().lexically_normal().generic_string());
+        }
+        std::sort(files.begin(), files.end());
+        return files;
+    }
+
+    std::ifstream in(source);
+    if (!in.is_open())
+        throw std::runtime_error("Cannot open directory or manifest: " + directoryOrManifest);
+
+    std::string line;
+    while (std::getline(in, line))
+    {
+        const size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#')
+            continue;
+        const size_t last = line.find_last_not_of(" \t\r");
+
+        fs::path file(line.substr(first, last - first + 1));
+        if (file.is_relative())
+            file = source.parent_path() / file;
+        files.push_back(file.lexically_normal().generic_string());
+    }
+    return files;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Solve.h"
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Solves a list of instances with one method and appends a RunRecord line per instance to
+// a results file. Instances below `largeCities` run side by side, one per slot with the
+// preset's "threads" parameter set to 1; the slots are TaskScheduler tasks. Larger ones
+// run one at a time with the preset's parallel configuration (the whole machine).
+// Instances that already have a successful record in the results file are skipped, so an
+// interrupted batch resumes where it stopped. A run cut short by the cancellation token
+// gets no record and is redone on resume.
+class BatchRunner
+{
+public:
+    struct Options
+    {
+        SolveSpec spec;            // method, params, init, criteria; the file fields are per instance
+        std::string resultsFile;   // JSON lines, appended
+        std::string tourDir;       // <stem>.tour per instance unless empty
+        int slots = 0;             // concurrent small instances, at most (and 0 =) one per scheduler thread
+        int largeCities = 5000;    // at least this many cities: the instance gets the machine
+    };
+
+    struct Summary
+    {
+        int solved = 0;
+        int skipped = 0;   // already in the results file
+        int failed = 0;
+        int interrupted = 0;
+    };
+
+    explicit BatchRunner(Options options);
+
+    // `onRecord` is called for every record written, from the thread that ran it, one
+    // call at a time. Throws std::runtime_error if the results file cannot be written.
+    Summary run(const std::vector<std::string>& instances,
+                const CancellationToken* cancel,
+                const std::function<void(const RunRecord&)>& onRecord = {});
+
+private:
+    struct Job
+    {
+        std::string file;
+        int cities = 0;
+    };
+
+    void solve(const Job& job, bool large, const CancellationToken* cancel);
+    void write(const RunRecord& record);
+
+    Options m_options;
+
+    std::function<void(const RunRecord&)> m_onRecord;
+    std::mutex m_writeMutex;
+    Summary m_summary;        // guarded by m_writeMutex while running
+    std::string m_writeError; // first failed write, reported once the slots are done
+};
+
+// The .tsp files of a directory (sorted), or those listed in a manifest: one path per
+// line, relative to the manifest's directory, blank lines and '#' comments ignored.
+// Paths come back normalized, so they match between runs. Throws std::runtime_error.
+std::vector<std::string> listInstances(const std::string& directoryOrManifest);
@@ -0,0 +1,54 @@
+#include "BestTourJournal.h"
+
+#include <algorithm>
+
+BestTourJournal::BestTourJournal(const Tour& initial)
+: m_best(initial),
+  m_bestCost(initial.cost())
+{
+}
+
+void BestTourJournal::markBest(double cost)
+{
+    m_bestCost = cost;
+    m_stale = true;
+    m_undo.clear();
+    m_undoWork = 0;
+}
+
+void BestTourJournal::recordReversal(int i, int j, const Tour& current)
+{
+    // best already materialized: the working tour may drift freely
+    if (!m_stale)
+        return;
+
+    m_undo.emplace_back(i, j);
+    m_undoWork += static_cast<long long>(j - i + 1);
+
+    // undoing is about to cost more than a copy: snapshot now and stop journaling
+    if (m_undoWork > static_cast<long long>(current.size()))
+        materialize(current);
+}
+
+const Tour& BestTourJournal::best(const Tour& current) const
+{
+    if (m_stale)
+        materialize(current);
+    return m_best;
+}
+
+void BestTourJournal::materialize(const Tour& current) const
+{
+    auto& ord = m_best.order();
+    ord = current.order(); // same size after the first copy: no reallocation
+
+    // reversals are self-inverse; undo newest first
+    for (auto it = m_undo.rbegin(); it != m_undo.rend(); ++it)
+        std::reverse(ord.begin() + it->first, ord.begin() + it->second + 1);
+
+    m_best.setCost(m_bestCost);
+
+    m_stale = false;
+    m_undo.clear();
+    m_undoWork = 0;
+}
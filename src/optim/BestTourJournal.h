@@ -0,0 +1,39 @@
+#pragma once
+
+#include "../Tour.h"
+
+#include <utility>
+#include <vector>
+
+// Lazy best-tour snapshot for single-trajectory optimizers (SA, 2-opt, ILS).
+// Instead of copying the working tour into the best tour on every improvement,
+// markBest() only remembers that "current == best". Segment reversals applied to the
+// working tour afterwards are kept in an undo journal, and the best tour is
+// materialized (copy current + undo the journal) only when someone asks for it,
+// or as soon as undoing would cost more than a plain copy (copy-on-stagnation).
+class BestTourJournal
+{
+public:
+    explicit BestTourJournal(const Tour& initial);
+
+    double cost() const { return m_bestCost; }
+
+    // The working tour is the new best. O(1).
+    void markBest(double cost);
+
+    // Positions [i..j] of the working tour were just reversed.
+    void recordReversal(int i, int j, const Tour& current);
+
+    // The best tour; `current` must be the working tour the journal refers to.
+    const Tour& best(const Tour& current) const;
+
+private:
+    void materialize(const Tour& current) const;
+
+    mutable Tour m_best;
+    mutable bool m_stale = false; // true while m_best lags behind the journal
+    mutable std::vector<std::pair<int,int>> m_undo;
+    mutable long long m_undoWork = 0;
+
+    double m_bestCost = 0.0;
+};
@@ -0,0 +1,490 @@
+#include "Crossover.h"
+
+#include <algorithm>
+#include <limits>
+
+Crossover::Crossover(const TspInstance* instance, const std::vector<int>* neighbors, int K)
+: m_instance(instance),
+  m_neighbors(neighbors),
+  m_K(K),
+  m_n(instance ? instance->size() : 0)
+{
+    const size_t n = static_cast<size_t>(m_n);
+    const size_t N = n + 1; // incl. depot
+
+    m_stamp.assign(N, 0);
+    m_adj.resize(4 * n);
+    m_adjCnt.resize(n);
+    m_unvisited.resize(n);
+    m_unvisitedPos.resize(n);
+
+    m_nbA.resize(2 * N);
+    m_nbB.resize(2 * N);
+    m_nbC.resize(2 * N);
+    m_aOnly.resize(2 * N);
+    m_bOnly.resize(2 * N);
+    m_aCnt.resize(N);
+    m_bCnt.resize(N);
+    m_evenPos.assign(N, -1);
+    m_path.reserve(2 * N + 2);
+    m_cycNodes.reserve(2 * N + 2);
+    m_cycStart.reserve(N);
+    m_comp.resize(N);
+    m_compSize.resize(N);
+    m_compRep.resize(N);
+    m_members.reserve(N);
+}
+
+int Crossover::nextStamp()
+{
+    if (++m_epoch == std::numeric_limits<int>::max())
+    {
+        std::fill(m_stamp.begin(), m_stamp.end(), 0);
+        m_epoch = 1;
+    }
+    return m_epoch;
+}
+
+void Crossover::apply(CrossoverKind kind, const int* a, const int* b, int* child, std::mt19937& rng)
+{
+    if (m_n < 8 || kind == CrossoverKind::None)
+    {
+        std::copy(a, a + m_n, child);
+        return;
+    }
+
+    switch (kind)
+    {
+        case CrossoverKind::OX:  orderCrossover(a, b, child, rng); break;
+        case CrossoverKind::ERX: edgeRecombination(a, b, child, rng); break;
+        case CrossoverKind::EAX: edgeAssembly(a, b, child, rng); break;
+        default: std::copy(a, a + m_n, child); break;
+    }
+}
+
+// --- OX -------------------------------------------------------------------
+
+void Crossover::orderCrossover(const int* a, const int* b, int* child, std::mt19937& rng)
+{
+    const int n = m_n;
+    std::uniform_int_distribution<int> dist(0, n - 1);
+    int i = dist(rng);
+    int j = dist(rng);
+    if (i > j) std::swap(i, j);
+
+    const int used = nextStamp();
+
+    // keep a[i..j] in place
+    for (int p = i; p <= j; ++p)
+    {
+        child[p] = a[p];
+        m_stamp[a[p]] = used;
+    }
+
+    // fill the rest in b's order, starting after the segment (wrap-around)
+    int write = (j + 1) % n;
+    for (int t = 0; t < n; ++t)
+    {
+        const int v = b[(j + 1 + t) % n];
+        if (m_stamp[v] == used) continue;
+        child[write] = v;
+        write = (write + 1) % n;
+    }
+}
+
+// --- ERX ------------------------------------------------------------------
+
+void Crossover::edgeRecombination(const int* a, const int* b, int* child, std::mt19937& rng)
+{
+    const int n = m_n;
+    const auto& pts = m_instance->points();
+
+    std::fill(m_adjCnt.begin(), m_adjCnt.end(), 0);
+    auto addEdge = [&](int u, int v){
+        int* row = &m_adj[4 * static_cast<size_t>(u)];
+        for (int k = 0; k < m_adjCnt[u]; ++k)
+            if (row[k] == v) return;
+        row[m_adjCnt[u]++] = v;
+    };
+    for (const int* p : { a, b })
+    {
+        for (int i = 0; i < n - 1; ++i)
+        {
+            addEdge(p[i], p[i + 1]);
+            addEdge(p[i + 1], p[i]);
+        }
+    }
+
+    for (int v = 0; v < n; ++v)
+    {
+        m_unvisited[v] = v;
+        m_unvisitedPos[v] = v;
+    }
+    int unvisitedCount = n;
+
+    const int visited = nextStamp();
+    const int* nbAll = m_neighbors ? m_neighbors->data() : nullptr;
+
+    int cur = a[0];
+    for (int k = 0; k < n; ++k)
+    {
+        child[k] = cur;
+        m_stamp[cur] = visited;
+
+        // swap-remove cur from the unvisited set
+        const int pos = m_unvisitedPos[cur];
+        const int last = m_unvisited[--unvisitedCount];
+        m_unvisited[pos] = last;
+        m_unvisitedPos[last] = pos;
+
+        // drop cur from its neighbors' edge lists
+        const int* row = &m_adj[4 * static_cast<size_t>(cur)];
+        for (int t = 0; t < m_adjCnt[cur]; ++t)
+        {
+            int* other = &m_adj[4 * static_cast<size_t>(row[t])];
+            int& cnt = m_adjCnt[row[t]];
+            for (int s = 0; s < cnt; ++s)
+            {
+                if (other[s] == cur) { other[s] = other[--cnt]; break; }
+            }
+        }
+
+        if (k == n - 1) break;
+
+        // prefer the parent edge whose endpoint has the fewest remaining edges (ties: random)
+        int next = -1;
+        int bestCnt = 5;
+        int ties = 0;
+        for (int t = 0; t < m_adjCnt[cur]; ++t)
+        {
+            const int v = row[t];
+            if (m_adjCnt[v] < bestCnt)
+            {
+                bestCnt = m_adjCnt[v];
+                next = v;
+                ties = 1;
+            }
+            else if (m_adjCnt[v] == bestCnt && std::uniform_int_distribution<int>(0, ties++)(rng) == 0)
+            {
+                next = v;
+            }
+        }
+
+        // dead end: nearest unvisited candidate instead of a random (long) jump
+        if (next < 0 && nbAll)
+        {
+            const int* nb = nbAll + static_cast<size_t>(cur) * static_cast<size_t>(m_K);
+            for (int t = 0; t < m_K; ++t)
+            {
+                if (m_stamp[nb[t]] != visited) { next = nb[t]; break; }
+            }
+        }
+
+        if (next < 0)
+        {
+            // closest of a few random unvisited nodes
+            double bestD = std::numeric_limits<double>::infinity();
+            std::uniform_int_distribution<int> pick(0, unvisitedCount - 1);
+            for (int t = 0; t < 8; ++t)
+            {
+                const int v = m_unvisited[pick(rng)];
+                const double d = Tour::edgeCost(pts[cur], pts[v]);
+                if (d < bestD) { bestD = d; next = v; }
+            }
+        }
+
+        cur = next;
+    }
+}
+
+// --- EAX ------------------------------------------------------------------
+
+double Crossover::dist(int u, int v) const
+{
+    if (u == m_n || v == m_n) return 0.0; // depot
+    const auto& pts = m_instance->points();
+    return Tour::edgeCost(pts[u], pts[v]);
+}
+
+void Crossover::buildCycleAdjacency(const int* ord, std::vector<int>& nb) const
+{
+    const int n = m_n;
+    const int depot = n;
+    for (int i = 0; i < n; ++i)
+    {
+        const int v = ord[i];
+        nb[2 * v]     = (i == 0) ? depot : ord[i - 1];
+        nb[2 * v + 1] = (i == n - 1) ? depot : ord[i + 1];
+    }
+    nb[2 * depot]     = ord[n - 1];
+    nb[2 * depot + 1] = ord[0];
+}
+
+void Crossover::replaceNeighbor(int u, int oldV, int newV)
+{
+    if (m_nbC[2 * u] == oldV) m_nbC[2 * u] = newV;
+    else                      m_nbC[2 * u + 1] = newV;
+}
+
+void Crossover::buildAbCycles(std::mt19937& rng)
+{
+    const int N = m_n + 1;
+
+    // A-only and B-only edges (common edges never take part in an AB-cycle)
+    for (int u = 0; u < N; ++u)
+    {
+        m_aCnt[u] = 0;
+        m_bCnt[u] = 0;
+        for (int s = 0; s < 2; ++s)
+        {
+            const int va = m_nbA[2 * u + s];
+            if (m_nbB[2 * u] != va && m_nbB[2 * u + 1] != va)
+                m_aOnly[2 * u + m_aCnt[u]++] = va;
+
+            const int vb = m_nbB[2 * u + s];
+            if (m_nbA[2 * u] != vb && m_nbA[2 * u + 1] != vb)
+                m_bOnly[2 * u + m_bCnt[u]++] = vb;
+        }
+    }
+
+    auto takeEdge = [&](std::vector<int>& lists, std::vector<int>& cnt, int u) -> int {
+        const int c = cnt[u];
+        const int s = (c > 1) ? std::uniform_int_distribution<int>(0, c - 1)(rng) : 0;
+        const int v = lists[2 * u + s];
+        lists[2 * u + s] = lists[2 * u + c - 1];
+        --cnt[u];
+        // remove the reverse direction
+        for (int t = 0; t < cnt[v]; ++t)
+        {
+            if (lists[2 * v + t] == u) { lists[2 * v + t] = lists[2 * v + cnt[v] - 1]; break; }
+        }
+        --cnt[v];
+        return v;
+    };
+
+    m_cycNodes.clear();
+    m_cycStart.clear();
+
+    // Alternate A- and B-edges; whenever a B-edge returns to a node that sits at an even
+    // path index (where an A-edge left), the tail of the path closes an AB-cycle.
+    for (int start = 0; start < N; ++start)
+    {
+        while (m_aCnt[start] > 0)
+        {
+            m_path.clear();
+            m_path.push_back(start);
+            m_evenPos[start] = 0;
+            int cur = start;
+
+            for (;;)
+            {
+                if (m_aCnt[cur] == 0)
+                {
+                    // only possible back at the start with everything closed
+                    for (size_t p = 0; p < m_path.size(); p += 2)
+                        m_evenPos[m_path[p]] = -1;
+                    break;
+                }
+
+                const int v = takeEdge(m_aOnly, m_aCnt, cur);
+                m_path.push_back(v);
+
+                const int w = takeEdge(m_bOnly, m_bCnt, v);
+                const int at = m_evenPos[w];
+                if (at >= 0)
+                {
+                    m_cycStart.push_back(static_cast<int>(m_cycNodes.size()));
+                    m_cycNodes.insert(m_cycNodes.end(), m_path.begin() + at, m_path.end());
+
+                    for (size_t p = static_cast<size_t>(at) + 2; p < m_path.size(); p += 2)
+                        m_evenPos[m_path[p]] = -1;
+                    m_path.resize(static_cast<size_t>(at) + 1);
+                    cur = w;
+                }
+                else
+                {
+                    m_path.push_back(w);
+                    m_evenPos[w] = static_cast<int>(m_path.size()) - 1;
+                    cur = w;
+                }
+            }
+        }
+    }
+    m_cycStart.push_back(static_cast<int>(m_cycNodes.size()));
+}
+
+void Crossover::applyAbCycle(int c)
+{
+    const int begin = m_cycStart[c];
+    const int len = m_cycStart[c + 1] - begin;
+    const int* cyc = m_cycNodes.data() + begin;
+
+    // drop the A-edges (c0,c1), (c2,c3), ...
+    for (int t = 0; t < len; t += 2)
+    {
+        const int x = cyc[t];
+        const int y = cyc[t + 1];
+        replaceNeighbor(x, y, -1);
+        replaceNeighbor(y, x, -1);
+    }
+    // add the B-edges (c1,c2), (c3,c4), ..., (c_last, c0)
+    for (int t = 1; t < len; t += 2)
+    {
+        const int x = cyc[t];
+        const int y = cyc[(t + 1) % len];
+        replaceNeighbor(x, -1, y);
+        replaceNeighbor(y, -1, x);
+    }
+}
+
+int Crossover::labelSubtours()
+{
+    const int N = m_n + 1;
+    std::fill(m_comp.begin(), m_comp.end(), -1);
+
+    int count = 0;
+    for (int v = 0; v < N; ++v)
+    {
+        if (m_comp[v] >= 0) continue;
+
+        int size = 0;
+        int prev = -1;
+        int cur = v;
+        do {
+            m_comp[cur] = count;
+            ++size;
+            const int nxt = (m_nbC[2 * cur] != prev) ? m_nbC[2 * cur] : m_nbC[2 * cur + 1];
+            prev = cur;
+            cur = nxt;
+        } while (cur != v);
+
+        m_compSize[count] = size;
+        m_compRep[count] = v;
+        ++count;
+    }
+    return count;
+}
+
+void Crossover::mergeSubtours(int subtours)
+{
+    const int N = m_n + 1;
+    int remaining = subtours;
+
+    while (remaining > 1)
+    {
+        // smallest live subtour
+        int U = -1;
+        for (int c = 0; c < subtours; ++c)
+            if (m_compSize[c] > 0 && (U < 0 || m_compSize[c] < m_compSize[U])) U = c;
+
+        m_members.clear();
+        {
+            const int v0 = m_compRep[U];
+            int prev = -1, cur = v0;
+            do {
+                m_members.push_back(cur);
+                const int nxt = (m_nbC[2 * cur] != prev) ? m_nbC[2 * cur] : m_nbC[2 * cur + 1];
+                prev = cur;
+                cur = nxt;
+            } while (cur != v0);
+        }
+
+        // best 2-exchange that joins U with another subtour
+        double best = std::numeric_limits<double>::infinity();
+        int bu = -1, bu2 = -1, bv = -1, bv2 = -1;
+        bool crossed = false;
+
+        auto consider = [&](int u, int v){
+            for (int s = 0; s < 2; ++s)
+            {
+                const int u2 = m_nbC[2 * u + s];
+                const double du = dist(u, u2);
+                for (int t = 0; t < 2; ++t)
+                {
+                    const int v2 = m_nbC[2 * v + t];
+                    const double base = du + dist(v, v2);
+                    const double g1 = dist(u, v) + dist(u2, v2) - base;
+                    const double g2 = dist(u, v2) + dist(u2, v) - base;
+                    if (g1 < best) { best = g1; bu = u; bu2 = u2; bv = v; bv2 = v2; crossed = false; }
+                    if (g2 < best) { best = g2; bu = u; bu2 = u2; bv = v; bv2 = v2; crossed = true; }
+                }
+            }
+        };
+
+        const int* nbAll = m_neighbors ? m_neighbors->data() : nullptr;
+        for (int u : m_members)
+        {
+            if (u == m_n || !nbAll) continue; // the depot has no neighbor list
+            const int* nb = nbAll + static_cast<size_t>(u) * static_cast<size_t>(m_K);
+            for (int k = 0; k < m_K; ++k)
+                if (m_comp[nb[k]] != U) consider(u, nb[k]);
+        }
+
+        if (bu < 0)
+        {
+            // all near neighbors are inside U (isolated cluster): full scan
+            for (int u : m_members)
+                for (int v = 0; v < N; ++v)
+                    if (m_comp[v] != U) consider(u, v);
+        }
+
+        const int V = m_comp[bv];
+        if (!crossed)
+        {
+            // (u,u2),(v,v2) -> (u,v),(u2,v2)
+            replaceNeighbor(bu, bu2, bv);
+            replaceNeighbor(bu2, bu, bv2);
+            replaceNeighbor(bv, bv2, bu);
+            replaceNeighbor(bv2, bv, bu2);
+        }
+        else
+        {
+            // (u,u2),(v,v2) -> (u,v2),(u2,v)
+            replaceNeighbor(bu, bu2, bv2);
+            replaceNeighbor(bu2, bu, bv);
+            replaceNeighbor(bv, bv2, bu2);
+            replaceNeighbor(bv2, bv, bu);
+        }
+
+        for (int u : m_members) m_comp[u] = V;
+        m_compSize[V] += m_compSize[U];
+        m_compSize[U] = 0;
+        --remaining;
+    }
+}
+
+void Crossover::edgeAssembly(const int* a, const int* b, int* child, std::mt19937& rng)
+{
+    const int n = m_n;
+    const int depot = n;
+
+    buildCycleAdjacency(a, m_nbA);
+    buildCycleAdjacency(b, m_nbB);
+
+    buildAbCycles(rng);
+    const int cycles = static_cast<int>(m_cycStart.size()) - 1;
+    if (cycles <= 0)
+    {
+        std::copy(a, a + n, child); // identical parents
+        return;
+    }
+
+    // single strategy: one random AB-cycle applied to parent A
+    std::copy(m_nbA.begin(), m_nbA.end(), m_nbC.begin());
+    applyAbCycle(std::uniform_int_distribution<int>(0, cycles - 1)(rng));
+
+    const int subtours = labelSubtours();
+    if (subtours > 1)
+        mergeSubtours(subtours);
+
+    // cut the cycle open at the depot
+    int prev = depot;
+    int cur = m_nbC[2 * depot];
+    for (int k = 0; k < n; ++k)
+    {
+        child[k] = cur;
+        const int nxt = (m_nbC[2 * cur] != prev) ? m_nbC[2 * cur] : m_nbC[2 * cur + 1];
+        prev = cur;
+        cur = nxt;
+    }
+}
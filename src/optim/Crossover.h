@@ -0,0 +1,71 @@
+#pragma once
+
+#include "../Tour.h"
+#include <random>
+#include <vector>
+
+enum class CrossoverKind
+{
+    None, // mutation only
+    OX,   // order crossover
+    ERX,  // edge recombination
+    EAX   // edge assembly (single AB-cycle strategy)
+};
+
+// Recombination operators for open tours stored as plain int arrays.
+// One instance per thread: it owns all scratch buffers, so apply() does not allocate
+// once the buffers have grown to their working size.
+//
+// EAX works on Hamiltonian cycles; an open tour is handled as a cycle through a virtual
+// depot node (index n) whose edges cost 0, which makes both representations equivalent.
+class Crossover
+{
+public:
+    // neighbors: flat K-nearest-neighbor lists (see SpatialGrid::buildNeighborLists)
+    Crossover(const TspInstance* instance, const std::vector<int>* neighbors, int K);
+
+    // Writes a child of parents a and b into `child` (must not alias a or b).
+    void apply(CrossoverKind kind, const int* a, const int* b, int* child, std::mt19937& rng);
+
+private:
+    void orderCrossover(const int* a, const int* b, int* child, std::mt19937& rng);
+    void edgeRecombination(const int* a, const int* b, int* child, std::mt19937& rng);
+    void edgeAssembly(const int* a, const int* b, int* child, std::mt19937& rng);
+
+    // EAX helpers (nodes 0..n, n = depot)
+    double dist(int u, int v) const;
+    void buildCycleAdjacency(const int* ord, std::vector<int>& nb) const;
+    void buildAbCycles(std::mt19937& rng);
+    void applyAbCycle(int c);
+    int labelSubtours();
+    void mergeSubtours(int subtours);
+    void replaceNeighbor(int u, int oldV, int newV);
+
+    int nextStamp();
+
+    const TspInstance* m_instance = nullptr;
+    const std::vector<int>* m_neighbors = nullptr;
+    int m_K = 0;
+    int m_n = 0;
+
+    // OX / ERX
+    std::vector<int> m_stamp; // epoch-stamped "used" markers
+    int m_epoch = 0;
+    std::vector<int> m_adj;   // ERX edge table, 4 slots per node
+    std::vector<int> m_adjCnt;
+    std::vector<int> m_unvisited;
+    std::vector<int> m_unvisitedPos;
+
+    // EAX
+    std::vector<int> m_nbA, m_nbB, m_nbC; // 2 neighbors per node
+    std::vector<int> m_aOnly, m_bOnly;    // A-only / B-only edges per node (2 slots)
+    std::vector<int> m_aCnt, m_bCnt;
+    std::vector<int> m_evenPos;
+    std::vector<int> m_path;
+    std::vector<int> m_cycNodes;
+    std::vector<int> m_cycStart;
+    std::vector<int> m_comp;
+    std::vector<int> m_compSize;
+    std::vector<int> m_compRep;
+    std::vector<int> m_members;
+};
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Lock-free sharing of the best tour between the units of a parallel optimizer.
+// Every unit owns one slot and only the thread running that unit writes it. offer() first
+// claims the global best by lowering a single atomic cost with compare-and-swap; only a
+// successful claim copies the tour into the unit's slot, so writers never contend on tour
+// data. Slots are seqlocks (the sequence number is odd while a copy is in progress): a
+// reader never blocks a writer and simply retries if it raced one.
+class EliteSnapshots
+{
+public:
+    // `slots` slots, all holding `order` at `cost`
+    EliteSnapshots(int slots, const std::vector<int>& order, double cost)
+    : m_cost(cost)
+    {
+        m_slots.reserve(static_cast<size_t>(slots));
+        for (int s = 0; s < slots; ++s)
+        {
+            auto slot = std::make_unique<Slot>();
+            slot->order = std::vector<std::atomic<int>>(order.size());
+            for (size_t p = 0; p < order.size(); ++p)
+                slot->order[p].store(order[p], std::memory_order_relaxed);
+            slot->cost.store(cost, std::memory_order_relaxed);
+            m_slots.push_back(std::move(slot));
+        }
+    }
+
+    EliteSnapshots(const EliteSnapshots&) = delete;
+    EliteSnapshots& operator=(const EliteSnapshots&) = delete;
+
+    // Publishes a tour from the unit owning `slot` if it beats the global best. Returns
+    // false otherwise; on success `*previous` (if given) gets the global cost it replaced.
+    bool offer(int slot, const std::vector<int>& order, double cost, double* previous = nullptr)
+    {
+        double global = m_cost.load(std::memory_order_relaxed);
+        while (cost < global && !m_cost.compare_exchange_weak(global, cost, std::memory_order_relaxed)) {}
+        if (!(cost < global))
+            return false;
+        if (previous)
+            *previous = global;
+
+        Slot& s = *m_slots[slot];
+        const unsigned seq = s.seq.load(std::memory_order_relaxed);
+        s.seq.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t p = 0; p < order.size(); ++p)
+            s.order[p].store(order[p], std::memory_order_relaxed);
+        s.cost.store(cost, std::memory_order_relaxed);
+        s.seq.store(seq + 2, std::memory_order_release);
+
+        m_version.fetch_add(1, std::memory_order_release);
+        return true;
+    }
+
+    // slot holding the cheapest tour
+    int eliteSlot() const
+    {
+        int best = 0;
+        for (int s = 1; s < static_cast<int>(m_slots.size()); ++s)
+        {
+            if (m_slots[s]->cost.load(std::memory_order_relaxed) < m_slots[best]->cost.load(std::memory_order_relaxed))
+                best = s;
+        }
+        return best;
+    }
+
+    // Copies the cheapest tour into `out` (sized to the tour) and returns its cost.
+    double readElite(std::vector<int>& out) const
+    {
+        const Slot& s = *m_slots[eliteSlot()];
+        for (;;)
+        {
+            const unsigned seq = s.seq.load(std::memory_order_acquire);
+            if (seq & 1u)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            for (size_t p = 0; p < out.size(); ++p)
+                out[p] = s.order[p].load(std::memory_order_relaxed);
+            const double cost = s.cost.load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (s.seq.load(std::memory_order_relaxed) == seq)
+                return cost;
+        }
+    }
+
+    double globalCost() const { return m_cost.load(std::memory_order_relaxed); }
+
+    // bumped by every successful offer(); a reader that saw the same value has nothing new
+    unsigned version() const { return m_version.load(std::memory_order_acquire); }
+
+private:
+    struct Slot
+    {
+        std::atomic<unsigned> seq { 0 };
+        std::vector<std::atomic<int>> order;
+        std::atomic<double> cost { 0.0 };
+    };
+
+    std::vector<std::unique_ptr<Slot>> m_slots;
+    std::atomic<double> m_cost;
+    std::atomic<unsigned> m_version { 0 };
+};
@@ -1,79 +1,294 @@
 #include "GeneticOptimizer.h"
+#include "../SpatialGrid.h"
 #include <algorithm>
 
-GeneticOptimizer::GeneticOptimizer(const Tour& initial, int populationSize, int mutationRate, uint32_t seed)
-: m_populationSize(populationSize),
+static constexpr int kNeighbors = 10;
+
+// Same operators as Tour::mutateSwap / mutateInsertion / mutateReverseSegment,
+// working on a population row in place.
+static void mutateSwap(int* ord, int n, std::mt19937& rng)
+{
+    if (n < 3) return;
+
+    std::uniform_int_distribution<int> dist(1, n - 2); // exclude 0 and last index, like Java
+    const int a = dist(rng);
+    const int b = dist(rng);
+    std::swap(ord[a], ord[b]);
+}
+
+static void mutateInsertion(int* ord, int n, std::mt19937& rng)
+{
+    if (n < 4) return;
+
+    std::uniform_int_distribution<int> dist(1, n - 2);
+    const int element = dist(rng);
+    const int insertAfter = dist(rng);
+    if (element == insertAfter) return;
+
+    // remove/insert expressed as a rotation (no erase/insert shuffling of the whole tail)
+    if (insertAfter > element)
+        std::rotate(ord + element, ord + element + 1, ord + insertAfter + 1);
+    else
+        std::rotate(ord + insertAfter + 1, ord + element, ord + element + 1);
+}
+
+static void mutateReverseSegment(int* ord, int n, std::mt19937& rng)
+{
+    if (n < 4) return;
+
+    std::uniform_int_distribution<int> dist(0, n - 1);
+    const int a = dist(rng);
+    const int b = dist(rng);
+    if (a == b) return;
+    const int i = std::min(a, b);
+    const int j = std::max(a, b);
+    if (j - i <= 1) return;
+
+    std::reverse(ord + i, ord + j + 1);
+}
+
+GeneticOptimizer::GeneticOptimizer(const Tour& initial,
+                                   int populationSize,
+                                   int mutationRate,
+                                   int threads,
+                                   CrossoverKind crossover,
+                                   bool localSearch,
+                                   uint32_t seed)
+: m_populationSize(std::max(1, populationSize)),
   m_mutationRate(std::max(1, mutationRate)),
+  m_crossover(crossover),
+  m_localSearch(localSearch),
   m_rng(seed),
-  m_population(),
+  m_instance(initial.instance()),
+  m_n(initial.size()),
   m_best(initial),
   m_baseline(initial.cost()),
   m_lastBest(initial.cost())
 {
-    m_population.reserve(m_populationSize);
-    for (int i = 0; i < m_populationSize; ++i)
-        m_population.push_back(initial); // copy
+    m_genes.resize(static_cast<size_t>(m_populationSize) * static_cast<size_t>(m_n));
+    for (int s = 0; s < m_populationSize; ++s)
+        std::copy(initial.order().begin(), initial.order().end(), row(s));
+
+    m_costs.assign(static_cast<size_t>(m_populationSize), initial.cost());
+
+    m_rank.resize(static_cast<size_t>(m_populationSize));
+    m_survivors.reserve(static_cast<size_t>(m_populationSize));
+    m_dead.reserve(static_cast<size_t>(m_populationSize));
+
+    m_slotRng.reserve(static_cast<size_t>(m_populationSize));
+    for (int s = 0; s < m_populationSize; ++s)
+    {
+        std::seed_seq seq{ seed, static_cast<uint32_t>(s) };
+        m_slotRng.emplace_back(seq);
+    }
+
+    if (threads != 1)
+    {
+        m_pool = &TaskScheduler::instance();
+        m_threads = (threads > 0) ? std::min(threads, m_pool->size()) : m_pool->size();
+    }
+
+    if (m_instance && (m_crossover != CrossoverKind::None || m_localSearch))
+    {
+        m_neighbors = SpatialGrid(*m_instance).buildNeighborLists(kNeighbors);
+        const int K = std::min(kNeighbors, std::max(0, m_n - 1));
+
+        const int contexts = m_pool ? m_pool->size() : 1;
+        for (int t = 0; t < contexts; ++t)
+            m_contexts.push_back(std::make_unique<BreedContext>(BreedContext{
+                Crossover(m_instance, &m_neighbors, K),
+                TwoOptLocalSearch(m_instance, &m_neighbors, K) }));
+    }
+
+    // a population of clones gives recombination nothing to work with
+    m_seeded = (m_crossover == CrossoverKind::None) ? m_populationSize : 1;
+}
+
+GeneticOptimizer::BreedContext& GeneticOptimizer::context()
+{
+    return *m_contexts[m_pool ? m_pool->workerIndex() : 0];
+}
+
+double GeneticOptimizer::costOf(const int* ord) const
+{
+    if (!m_instance || m_n < 2) return 0.0;
+    const auto& pts = m_instance->points();
+
+    double sum = 0.0;
+    for (int i = 0; i < m_n - 1; ++i)
+        sum += Tour::edgeCost(pts[ord[i]], pts[ord[i + 1]]);
+    return sum;
+}
+
+bool GeneticOptimizer::updateBest(int slot)
+{
+    // reuses m_best's storage
+    const double c = m_costs[slot];
+    if (c < m_lastBest)
+    {
+        m_best.order().assign(row(slot), row(slot) + m_n);
+        m_best.setCost(c);
+        m_lastBest = c;
+        return true;
+    }
+    return false;
+}
+
+void GeneticOptimizer::immigrate(const std::vector<int>& order)
+{
+    if (static_cast<int>(order.size()) != m_n || m_n < 2) return;
+
+    int worst = 0;
+    for (int s = 1; s < m_populationSize; ++s)
+        if (m_costs[s] > m_costs[worst]) worst = s;
+
+    const double c = costOf(order.data());
+    if (c >= m_costs[worst]) return;
+
+    std::copy(order.begin(), order.end(), row(worst));
+    m_costs[worst] = c;
+    updateBest(worst);
+}
+
+void GeneticOptimizer::seedSlot(int slot)
+{
+    // perturbed copy of the initial tour, polished by the local search if enabled
+    std::mt19937& rng = m_slotRng[slot];
+    int* ord = row(slot);
+
+    const int kicks = std::max(8, std::min(500, m_n / 20));
+    std::uniform_int_distribution<int> whichMut(0, 2);
+    for (int j = 0; j < kicks; ++j)
+    {
+        switch (whichMut(rng))
+        {
+            case 0: mutateInsertion(ord, m_n, rng); break;
+            case 1: mutateSwap(ord, m_n, rng); break;
+            case 2: mutateReverseSegment(ord, m_n, rng); break;
+        }
+    }
+
+    if (m_localSearch)
+        context().localSearch.optimize(ord);
+
+    m_costs[slot] = costOf(ord);
 }
 
 bool GeneticOptimizer::iterate()
 {
-    // step 1: rank by fitness (lower is better)
-    std::sort(m_population.begin(), m_population.end(),
-              [](const Tour& a, const Tour& b){ return a.cost() < b.cost(); });
+    if (m_n < 2) return false;
 
-    m_best = m_population.front();
+    // diversify the initial clones a batch at a time, so a step stays short
+    if (m_seeded < m_populationSize)
+    {
+        const int first = m_seeded;
+        const int last = std::min(m_populationSize, first + m_threads);
+        if (m_pool)
+            m_pool->parallelFor(first, last, [this](int slot){ if (!cancelled()) seedSlot(slot); }, m_threads);
+        else
+            for (int slot = first; slot < last && !cancelled(); ++slot) seedSlot(slot);
+        m_seeded = last;
 
-    // step 2: probabilistic death (similar to Java)
+        bool improved = false;
+        for (int slot = first; slot < last; ++slot)
+            improved = updateBest(slot) || improved;
+        return improved;
+    }
+
+    // step 1: rank slots by fitness (lower is better)
+    for (int s = 0; s < m_populationSize; ++s) m_rank[s] = s;
+    std::sort(m_rank.begin(), m_rank.end(),
+              [&](int a, int b){ return m_costs[a] < m_costs[b]; });
+
+    // step 2: probabilistic death (similar to Java); the best always survives
     std::uniform_real_distribution<double> uni01(0.0, 1.0);
 
-    std::vector<Tour> survivors;
-    survivors.reserve(m_populationSize);
+    m_survivors.clear();
+    m_dead.clear();
 
-    survivors.push_back(m_population[0]);
+    m_survivors.push_back(m_rank[0]);
     for (int i = 1; i < m_populationSize; ++i)
     {
         const double pDie = static_cast<double>(i) / static_cast<double>(m_populationSize);
         if (uni01(m_rng) >= pDie)
-            survivors.push_back(m_population[i]);
+            m_survivors.push_back(m_rank[i]);
+        else
+            m_dead.push_back(m_rank[i]);
     }
 
-    const int dead = m_populationSize - static_cast<int>(survivors.size());
-    if (survivors.empty())
-        survivors.push_back(m_population[0]);
+    // step 3: refill dead slots with mutated clones of survivors (in place).
+    // Each task only writes its own row/cost and reads surviving rows.
+    if (m_pool)
+        m_pool->parallelFor(0, static_cast<int>(m_dead.size()), [this](int t){ if (!cancelled()) breed(m_dead[t]); }, m_threads);
+    else
+        for (size_t t = 0; t < m_dead.size() && !cancelled(); ++t) breed(m_dead[t]);
+
+    int bestSlot = m_rank[0];
+    for (int slot : m_dead)
+        if (m_costs[slot] < m_costs[bestSlot])
+            bestSlot = slot;
+
+    return updateBest(bestSlot);
+}
 
-    // step 3: repopulate by mutating clones
-    std::uniform_int_distribution<int> pickParent(0, static_cast<int>(survivors.size()) - 1);
+bool GeneticOptimizer::iterateBatch(int maxSteps, Clock::time_point deadline)
+{
+    return runBatch(*this, maxSteps, deadline, 1);
+}
+
+bool GeneticOptimizer::inject(const std::vector<int>& order, double cost)
+{
+    (void)cost; // immigrate() evaluates the tour itself
+    if (static_cast<int>(order.size()) != m_n)
+        return false;
+    immigrate(order);
+    return true;
+}
+
+void GeneticOptimizer::setCancellation(const CancellationToken* token)
+{
+    IOptimizer::setCancellation(token);
+    for (auto& ctx : m_contexts)
+        ctx->localSearch.setCancellation(token);
+}
+
+void GeneticOptimizer::breed(int slot)
+{
+    std::mt19937& rng = m_slotRng[slot];
+
+    std::uniform_int_distribution<int> pickParent(0, static_cast<int>(m_survivors.size()) - 1);
     std::uniform_int_distribution<int> howManyMut(0, m_mutationRate - 1);
     std::uniform_int_distribution<int> whichMut(0, 2);
 
-    for (int i = 0; i < dead; ++i)
+    const int parent = m_survivors[pickParent(rng)];
+    int* baby = row(slot);
+
+    if (m_crossover != CrossoverKind::None && m_survivors.size() > 1)
+    {
+        int mate = m_survivors[pickParent(rng)];
+        while (mate == parent)
+            mate = m_survivors[pickParent(rng)];
+        context().crossover.apply(m_crossover, row(parent), row(mate), baby, rng);
+    }
+    else
+    {
+        std::copy(row(parent), row(parent) + m_n, baby);
+    }
+
+    const int k = howManyMut(rng);
+    for (int j = 0; j < k; ++j)
     {
-        Tour baby = survivors[pickParent(m_rng)];
-        const int k = howManyMut(m_rng);
-        for (int j = 0; j < k; ++j)
+        switch (whichMut(rng))
         {
-            switch (whichMut(m_rng))
-            {
-                case 0: baby.mutateInsertion(m_rng); break;
-                case 1: baby.mutateSwap(m_rng); break;
-                case 2: baby.mutateReverseSegment(m_rng); break;
-            }
+            case 0: mutateInsertion(baby, m_n, rng); break;
+            case 1: mutateSwap(baby, m_n, rng); break;
+            case 2: mutateReverseSegment(baby, m_n, rng); break;
         }
-        baby.evaluate();
-        survivors.push_back(std::move(baby));
     }
 
-    m_population = std::move(survivors);
+    // the parent is locally optimal already: only the changed stretches need the search
+    if (m_localSearch)
+        context().localSearch.optimizeChanged(baby, row(parent));
 
-    // update best
-    std::sort(m_population.begin(), m_population.end(),
-              [](const Tour& a, const Tour& b){ return a.cost() < b.cost(); });
-    const double currentBest = m_population.front().cost();
-    if (currentBest < m_lastBest)
-    {
-        m_best = m_population.front();
-        m_lastBest = currentBest;
-        return true;
-    }
-    return false;
+    m_costs[slot] = costOf(baby);
 }
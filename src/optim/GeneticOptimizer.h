@@ -1,28 +1,83 @@
 #pragma once
 
 #include "IOptimizer.h"
+#include "Crossover.h"
+#include "LocalSearch.h"
+#include "TaskScheduler.h"
+#include <memory>
 #include <vector>
 #include <random>
 
+// Steady-replacement GA. Offspring are a recombination of two survivors (OX, ERX or EAX,
+// or a plain clone when crossover is off), then mutated and optionally polished by a
+// neighbor-list 2-opt that starts from the nodes whose edges differ from the first parent's.
+// The population lives in one contiguous (pop x n) buffer that is reused in place;
+// selection works on slot indices and a cost array, so a generation performs no heap
+// allocation.
 class GeneticOptimizer final : public IOptimizer
 {
 public:
     GeneticOptimizer(const Tour& initial,
                      int populationSize = 30,
                      int mutationRate = 2,
+                     int threads = 1, // 1 = serial, 0 = all cores
+                     CrossoverKind crossover = CrossoverKind::None,
+                     bool localSearch = false,
                      uint32_t seed = std::random_device{}());
 
     bool iterate() override;
+    bool iterateBatch(int maxSteps, Clock::time_point deadline) override;
+    bool inject(const std::vector<int>& order, double cost) override;
+    void setCancellation(const CancellationToken* token) override;
     const Tour& bestTour() const override { return m_best; }
     double baselineCost() const override { return m_baseline; }
 
+    // Island-model migration: the migrant replaces the worst slot if it is better.
+    void immigrate(const std::vector<int>& order);
+
 private:
+    int* row(int slot) { return m_genes.data() + static_cast<size_t>(slot) * static_cast<size_t>(m_n); }
+    const int* row(int slot) const { return m_genes.data() + static_cast<size_t>(slot) * static_cast<size_t>(m_n); }
+
+    double costOf(const int* ord) const;
+    void breed(int slot);
+    void seedSlot(int slot);
+    bool updateBest(int slot);
+
+    // per-thread operator scratch
+    struct BreedContext
+    {
+        Crossover crossover;
+        TwoOptLocalSearch localSearch;
+    };
+    BreedContext& context();
+
     int m_populationSize = 30;
     int m_mutationRate = 2;
+    CrossoverKind m_crossover = CrossoverKind::None;
+    bool m_localSearch = false;
 
     std::mt19937 m_rng;
 
-    std::vector<Tour> m_population;
+    const TspInstance* m_instance = nullptr;
+    int m_n = 0;
+
+    std::vector<int> m_genes;    // slot s occupies [s*n, (s+1)*n)
+    std::vector<double> m_costs; // cost per slot
+    std::vector<std::mt19937> m_slotRng; // offspring RNG stream per slot
+
+    // per-generation scratch (sized once)
+    std::vector<int> m_rank;      // slots sorted by cost ascending
+    std::vector<int> m_survivors; // surviving slots
+    std::vector<int> m_dead;      // slots to be refilled
+
+    TaskScheduler* m_pool = nullptr; // shared scheduler; null in serial mode
+    int m_threads = 1;               // threads per parallelFor
+
+    std::vector<int> m_neighbors; // K-nearest lists for EAX/ERX and the local search
+    std::vector<std::unique_ptr<BreedContext>> m_contexts; // one per thread
+    int m_seeded = 0; // slots diversified so far (crossover needs a diverse population)
+
     Tour m_best;
     double m_baseline = 0.0;
     double m_lastBest = 0.0;
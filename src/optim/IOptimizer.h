@@ -1,15 +1,81 @@
 #pragma once
 
 #include "../Tour.h"
+#include "../CancellationToken.h"
+
+#include <chrono>
+#include <vector>
 
 class IOptimizer
 {
 public:
+    using Clock = std::chrono::steady_clock;
+
     virtual ~IOptimizer() = default;
 
     // Do a small step/iteration. Return true if the internal best solution improved.
     virtual bool iterate() = 0;
 
+    // Do up to maxSteps iterate() steps, stopping early once the deadline has passed.
+    // Return true if the best solution improved during the batch.
+    virtual bool iterateBatch(int maxSteps, Clock::time_point deadline)
+    {
+        bool improved = false;
+        int step = 0;
+        for (; step < maxSteps && Clock::now() < deadline && !cancelled(); ++step)
+            improved = iterate() || improved;
+        m_steps += step;
+        return improved;
+    }
+
+    // Continue the search from an outside tour (e.g. the elite of a portfolio). `cost` is the
+    // tour's exact cost. Return false if the optimizer does not take outside tours.
+    virtual bool inject(const std::vector<int>& order, double cost)
+    {
+        (void)order;
+        (void)cost;
+        return false;
+    }
+
     virtual const Tour& bestTour() const = 0;
     virtual double baselineCost() const = 0;
+
+    // iterate() steps taken through iterateBatch() so far. For the optimizers that run
+    // units in parallel (island GA, ILS pool, portfolio) it is the steps of all units.
+    long long steps() const { return m_steps; }
+
+    // Long steps poll `token` at bounded intervals and return early once it is cancelled,
+    // leaving the optimizer consistent. The token must outlive the optimizer; optimizers
+    // that own others or local searches pass it on.
+    virtual void setCancellation(const CancellationToken* token) { m_cancel = token; }
+
+protected:
+    bool cancelled() const { return m_cancel && m_cancel->cancelled(); }
+
+    // Batch loop shared by the optimizers: calls Derived::iterate() directly (no virtual
+    // dispatch) and only reads the clock every clockStride steps, so cheap steps are not
+    // dominated by the bookkeeping around them.
+    template <typename Derived>
+    static bool runBatch(Derived& self, int maxSteps, Clock::time_point deadline, int clockStride)
+    {
+        bool improved = false;
+        int untilCheck = clockStride;
+        int step = 0;
+        while (step < maxSteps)
+        {
+            improved = self.Derived::iterate() || improved;
+            ++step;
+            if (--untilCheck == 0)
+            {
+                if (Clock::now() >= deadline || static_cast<const IOptimizer&>(self).cancelled())
+                    break;
+                untilCheck = clockStride;
+            }
+        }
+        static_cast<IOptimizer&>(self).m_steps += step;
+        return improved;
+    }
+
+    const CancellationToken* m_cancel = nullptr;
+    long long m_steps = 0;
 };
@@ -1,16 +1,39 @@
 #include "IlsOptimizer.h"
+#include "../SpatialGrid.h"
 
 #include <algorithm>
 
-IlsOptimizer::IlsOptimizer(const Tour& initial, int checksPerIter, int stagnationIters, uint32_t seed)
+static constexpr int kNeighbors = 10;
+static constexpr int kKickSpan = 50; // max tour distance between the kick's cut points
+
+IlsOptimizer::IlsOptimizer(const Tour& initial, int checksPerIter, int stagnationIters, bool localized,
+                           Acceptance acceptance, uint32_t seed)
 : m_checksPerIter(std::max(250, checksPerIter)),
   m_stagnationIters(std::max(10, stagnationIters)),
   m_noImprove(0),
+  m_localized(localized),
+  m_acceptance(acceptance),
   m_rng(seed),
   m_current(initial),
   m_best(initial),
   m_baseline(initial.cost())
 {
+    const TspInstance* inst = initial.instance();
+    if (m_localized && inst && m_current.size() >= 8)
+    {
+        m_neighbors = SpatialGrid(*inst).buildNeighborLists(kNeighbors);
+        const int K = std::min(kNeighbors, m_current.size() - 1);
+        m_localSearch = std::make_unique<TwoOptLocalSearch>(inst, &m_neighbors, K, true);
+
+        // every change to the working tour goes through the local search; journal it for the
+        // lazy best snapshot and for undoing a rejected kick
+        m_localSearch->setReversalObserver([this](int i, int j)
+        {
+            m_best.recordReversal(i, j, m_current);
+            if (!m_undoing)
+                m_kickUndo.emplace_back(i, j);
+        });
+    }
 }
 
 double IlsOptimizer::deltaReverseOpen(const std::vector<TspPoint>& pts,
@@ -82,20 +105,26 @@ bool IlsOptimizer::applyBest2OptMove()
     if (bestI >= 0)
     {
         std::reverse(ord.begin() + bestI, ord.begin() + bestJ + 1);
-        m_current.evaluate();
+        m_current.setCost(m_current.cost() + bestDelta);
+        m_best.recordReversal(bestI, bestJ, m_current);
         return true;
     }
 
     return false;
 }
 
+void IlsOptimizer::reverseAndRecord(int i, int j)
+{
+    auto& ord = m_current.order();
+    std::reverse(ord.begin() + i, ord.begin() + j + 1);
+    m_best.recordReversal(i, j, m_current);
+}
+
 void IlsOptimizer::doubleBridgePerturbation()
 {
     const int n = m_current.size();
     if (n < 8) return;
 
-    auto& ord = m_current.order();
-
     // Choose 4 cut points i < j < k < l to create 5 segments:
     // A=[0..i-1], B=[i..j-1], C=[j..k-1], D=[k..l-1], E=[l..n-1]
     // New order: A + C + B + D + E  (classic double-bridge style for permutations)
@@ -109,18 +138,162 @@ void IlsOptimizer::doubleBridgePerturbation()
     int k = dk(m_rng);
 
     std::uniform_int_distribution<int> dl(k + 1, n - 2);
-    int l = dl(m_rng);
+    (void)dl(m_rng); // D and E keep their place; draw l anyway to keep the RNG stream unchanged
+
+    // only the three junctions change: A|B, B|C, C|D  ->  A|C, C|B, B|D
+    const auto& pts = m_current.instance()->points();
+    const auto& ord = m_current.order();
+    const int a = ord[i - 1], b0 = ord[i], b1 = ord[j - 1];
+    const int c0 = ord[j], c1 = ord[k - 1], d = ord[k];
+    const double delta = Tour::edgeCost(pts[a], pts[c0]) + Tour::edgeCost(pts[c1], pts[b0]) + Tour::edgeCost(pts[b1], pts[d])
+                       - Tour::edgeCost(pts[a], pts[b0]) - Tour::edgeCost(pts[b1], pts[c0]) - Tour::edgeCost(pts[c1], pts[d]);
 
-    std::vector<int> newOrd;
-    newOrd.reserve(n);
+    // swap the adjacent blocks B and C in place: rev(B), rev(C), rev(B+C).
+    // Expressed as reversals so the best-tour journal can undo it.
+    reverseAndRecord(i, j - 1);
+    reverseAndRecord(j, k - 1);
+    reverseAndRecord(i, k - 1);
+    m_current.setCost(m_current.cost() + delta);
+}
 
-    newOrd.insert(newOrd.end(), ord.begin(), ord.begin() + i);       // A
-    newOrd.insert(newOrd.end(), ord.begin() + j, ord.begin() + k);   // C
-    newOrd.insert(newOrd.end(), ord.begin() + i, ord.begin() + j);   // B
-    newOrd.insert(newOrd.end(), ord.begin() + k, ord.begin() + l);   // D
-    newOrd.insert(newOrd.end(), ord.begin() + l, ord.end());         // E
+bool IlsOptimizer::pickLocalCuts(int& i, int& j, int& k)
+{
+    const int n = m_current.size();
+    const int K = static_cast<int>(m_neighbors.size() / static_cast<size_t>(n));
+    std::uniform_int_distribution<int> pickNode(0, n - 1);
+    std::uniform_int_distribution<int> coin(0, 1);
 
-    ord = std::move(newOrd);
+    for (int attempt = 0; attempt < 8; ++attempt)
+    {
+        // a cut at position q drops the edge (q-1, q); cut next to v and to those of its
+        // spatial neighbors that are close by in the tour, so the blocks stay short and the
+        // new edges connect nearby cities
+        const int v = pickNode(m_rng);
+        const int p = m_localSearch->position(v);
+
+        int cuts[kNeighbors + 1];
+        int count = 0;
+        cuts[count++] = p + coin(m_rng);
+        const int* nb = m_neighbors.data() + static_cast<size_t>(v) * static_cast<size_t>(K);
+        for (int t = 0; t < K; ++t)
+        {
+            const int q = m_localSearch->position(nb[t]);
+            if (q >= p - kKickSpan && q <= p + kKickSpan)
+                cuts[count++] = q + coin(m_rng);
+        }
+        if (count < 3)
+            continue;
+
+        std::shuffle(cuts, cuts + count, m_rng);
+        std::sort(cuts, cuts + 3);
+        i = cuts[0]; j = cuts[1]; k = cuts[2];
+        if (i >= 1 && i < j && j < k && k <= n - 1)
+            return true;
+    }
+    return false;
+}
+
+double IlsOptimizer::swapBlocks(int i, int j, int k)
+{
+    // only the three junctions change: A|B, B|C, C|D  ->  A|C, C|B, B|D
+    const auto& pts = m_current.instance()->points();
+    auto& ord = m_current.order();
+    const int a = ord[i - 1], b0 = ord[i], b1 = ord[j - 1];
+    const int c0 = ord[j], c1 = ord[k - 1], d = ord[k];
+    const double delta = Tour::edgeCost(pts[a], pts[c0]) + Tour::edgeCost(pts[c1], pts[b0]) + Tour::edgeCost(pts[b1], pts[d])
+                       - Tour::edgeCost(pts[a], pts[b0]) - Tour::edgeCost(pts[b1], pts[c0]) - Tour::edgeCost(pts[c1], pts[d]);
+
+    // rev(B), rev(C), rev(B+C); each reversal resets the don't-look bits of its endpoints
+    if (j - 1 > i) m_localSearch->reverse(ord.data(), i, j - 1);
+    if (k - 1 > j) m_localSearch->reverse(ord.data(), j, k - 1);
+    m_localSearch->reverse(ord.data(), i, k - 1);
+    return delta;
+}
+
+bool IlsOptimizer::iterateLocalized()
+{
+    auto& ord = m_current.order();
+
+    if (!m_attached)
+    {
+        // descend to a local optimum once; later iterations only repair around the kicks
+        m_attached = true;
+        m_current.setCost(m_current.cost() + m_localSearch->optimize(ord.data()));
+        m_kickUndo.clear();
+        if (m_current.cost() < m_best.cost())
+        {
+            m_best.markBest(m_current.cost());
+            return true;
+        }
+        return false;
+    }
+
+    int i = 0, j = 0, k = 0;
+    if (!pickLocalCuts(i, j, k))
+        return false;
+
+    const double before = m_current.cost();
+    m_kickUndo.clear();
+    const double delta = swapBlocks(i, j, k) + m_localSearch->improve(ord.data());
+
+    bool accept = (delta <= 0.0) || m_acceptance == Acceptance::RandomWalk;
+    if (m_burst > 0)
+    {
+        --m_burst;
+        accept = true;
+    }
+
+    if (accept)
+    {
+        m_current.setCost(before + delta);
+        if (m_current.cost() < m_best.cost())
+        {
+            m_best.markBest(m_current.cost());
+            m_sinceBest = 0;
+            return true;
+        }
+    }
+
+    if (m_acceptance == Acceptance::Restart && ++m_sinceBest >= std::max(1000LL, 2LL * m_current.size()))
+    {
+        m_burst = std::max(10, m_current.size() / 50);
+        m_sinceBest = 0;
+    }
+
+    if (accept)
+        return false;
+
+    // worse: undo the kick and its repair, newest first
+    m_undoing = true;
+    for (auto it = m_kickUndo.rbegin(); it != m_kickUndo.rend(); ++it)
+        m_localSearch->reverse(ord.data(), it->first, it->second);
+    m_undoing = false;
+    m_current.setCost(before);
+    return false;
+}
+
+void IlsOptimizer::restartFrom(const std::vector<int>& order, double cost)
+{
+    if (static_cast<int>(order.size()) != m_current.size())
+        return;
+
+    // snapshot the chain's own best before the working tour stops being derived from it
+    m_best.best(m_current);
+
+    m_current.order().assign(order.begin(), order.end());
+    m_current.setCost(cost);
+    if (m_localSearch)
+    {
+        m_localSearch->attach(m_current.order().data());
+        m_attached = true; // the elite is already a local optimum
+        m_kickUndo.clear();
+    }
+    m_noImprove = 0;
+    m_sinceBest = 0;
+    m_burst = 0;
+
+    if (cost < m_best.cost())
+        m_best.markBest(cost);
 }
 
 bool IlsOptimizer::iterate()
@@ -128,6 +301,9 @@ bool IlsOptimizer::iterate()
     const int n = m_current.size();
     if (n < 4) return false;
 
+    if (m_localSearch)
+        return iterateLocalized();
+
     bool improvedBest = false;
 
     if (applyBest2OptMove())
@@ -135,7 +311,7 @@ bool IlsOptimizer::iterate()
         m_noImprove = 0;
         if (m_current.cost() < m_best.cost())
         {
-            m_best = m_current;
+            m_best.markBest(m_current.cost());
             improvedBest = true;
         }
     }
@@ -145,12 +321,11 @@ bool IlsOptimizer::iterate()
         if (m_noImprove >= m_stagnationIters)
         {
             doubleBridgePerturbation();
-            m_current.evaluate();
             m_noImprove = 0;
 
             if (m_current.cost() < m_best.cost())
             {
-                m_best = m_current;
+                m_best.markBest(m_current.cost());
                 improvedBest = true;
             }
         }
@@ -158,3 +333,23 @@ bool IlsOptimizer::iterate()
 
     return improvedBest;
 }
+
+bool IlsOptimizer::iterateBatch(int maxSteps, Clock::time_point deadline)
+{
+    return runBatch(*this, maxSteps, deadline, 32);
+}
+
+bool IlsOptimizer::inject(const std::vector<int>& order, double cost)
+{
+    if (static_cast<int>(order.size()) != m_current.size())
+        return false;
+    restartFrom(order, cost);
+    return true;
+}
+
+void IlsOptimizer::setCancellation(const CancellationToken* token)
+{
+    IOptimizer::setCancellation(token);
+    if (m_localSearch)
+        m_localSearch->setCancellation(token);
+}
@@ -1,25 +1,52 @@
 #pragma once
 
 #include "IOptimizer.h"
+#include "BestTourJournal.h"
+#include "LocalSearch.h"
 
+#include <memory>
 #include <random>
+#include <utility>
 #include <vector>
 
 // Iterated Local Search (ILS) for open TSP tours.
 // - Uses 2-opt local improvement.
 // - When stagnating, applies a "double-bridge" perturbation to escape local minima.
+//
+// Localized mode (default): each iterate() is one kick + repair. The cut points of the
+// double-bridge are a random city and some of its spatial neighbors that sit close by in
+// the tour, the blocks are swapped in place, and only the kick endpoints are handed to the
+// neighbor-list 2-opt/or-opt, so a kick costs O(segment) instead of O(n). A kick that makes
+// the tour worse is undone under the default better-or-equal acceptance; RandomWalk accepts
+// every kick, Restart accepts like Better but, after about 2n kicks without a new best,
+// diversifies with a burst of unconditional kicks.
+// Classic mode keeps the random-sampled 2-opt and tour-wide kicks (checksPerIter and
+// stagnationIters apply to it only).
 class IlsOptimizer final : public IOptimizer
 {
 public:
+    enum class Acceptance { Better, RandomWalk, Restart };
+
     explicit IlsOptimizer(const Tour& initial,
                          int checksPerIter = 2500,
                          int stagnationIters = 150,
+                         bool localized = true,
+                         Acceptance acceptance = Acceptance::Better,
                          uint32_t seed = std::random_device{}());
 
     bool iterate() override;
-    const Tour& bestTour() const override { return m_best; }
+    bool iterateBatch(int maxSteps, Clock::time_point deadline) override;
+    bool inject(const std::vector<int>& order, double cost) override;
+    void setCancellation(const CancellationToken* token) override;
+    const Tour& bestTour() const override { return m_best.best(m_current); }
     double baselineCost() const override { return m_baseline; }
 
+    double currentCost() const { return m_current.cost(); }
+    double bestCost() const { return m_best.cost(); }
+
+    // Multi-start pools: continue the chain from `order` (e.g. the shared elite tour).
+    void restartFrom(const std::vector<int>& order, double cost);
+
 private:
     static double deltaReverseOpen(const std::vector<TspPoint>& pts,
                                    const std::vector<int>& ord,
@@ -28,14 +55,31 @@ private:
 
     bool applyBest2OptMove();
     void doubleBridgePerturbation();
+    void reverseAndRecord(int i, int j);
+
+    // localized mode
+    bool iterateLocalized();
+    bool pickLocalCuts(int& i, int& j, int& k);
+    double swapBlocks(int i, int j, int k); // B=[i..j-1], C=[j..k-1] -> C B; returns the delta
 
     int m_checksPerIter = 2500;
     int m_stagnationIters = 150;
     int m_noImprove = 0;
 
+    bool m_localized = true;
+    std::vector<int> m_neighbors; // K-nearest lists for the local search and the kicks
+    std::unique_ptr<TwoOptLocalSearch> m_localSearch;
+    bool m_attached = false;      // the first localized iterate() runs a full local search
+    std::vector<std::pair<int,int>> m_kickUndo; // reversals since the last kick
+    bool m_undoing = false;
+
+    Acceptance m_acceptance = Acceptance::Better;
+    long long m_sinceBest = 0; // kicks since the last new best (Restart acceptance)
+    int m_burst = 0;           // unconditional kicks left in the current restart burst
+
     std::mt19937 m_rng;
 
     Tour m_current;
-    Tour m_best;
+    BestTourJournal m_best; // lazily materialized snapshot of the best m_current
     double m_baseline = 0.0;
 };
@@ -0,0 +1,155 @@
+#include "IlsPoolOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    int chainCount(int chains)
+    {
+        return (chains > 0) ? chains : TaskScheduler::instance().size();
+    }
+}
+
+IlsPoolOptimizer::IlsPoolOptimizer(const Tour& initial,
+                                   int chains,
+                                   int threads,
+                                   IlsOptimizer::Acceptance acceptance,
+                                   int restartIntervalMs,
+                                   double restartFraction,
+                                   uint32_t seed)
+: m_restartIntervalMs(std::max(1, restartIntervalMs)),
+  m_restartFraction(std::clamp(restartFraction, 0.0, 1.0)),
+  m_elite(chainCount(chains), initial.order(), initial.cost()),
+  m_best(initial),
+  m_baseline(initial.cost()),
+  m_runner(chainCount(chains), threads,
+           [this](int index, Clock::time_point deadline, int maxSteps){ return chainSlice(index, deadline, maxSteps); })
+{
+    chains = chainCount(chains);
+
+    std::seed_seq seq{ seed };
+    std::vector<uint32_t> seeds(static_cast<size_t>(chains));
+    seq.generate(seeds.begin(), seeds.end());
+
+    const int n = initial.size();
+    m_chains.reserve(static_cast<size_t>(chains));
+    for (int c = 0; c < chains; ++c)
+    {
+        auto chain = std::make_unique<Chain>();
+        chain->ils = std::make_unique<IlsOptimizer>(initial, 2500, 150, true, acceptance, seeds[c]);
+        chain->currentCost.store(initial.cost(), std::memory_order_relaxed);
+        m_chains.push_back(std::move(chain));
+    }
+
+    m_scratch.resize(static_cast<size_t>(n));
+}
+
+IlsPoolOptimizer::~IlsPoolOptimizer()
+{
+    m_runner.stop();
+}
+
+void IlsPoolOptimizer::setCancellation(const CancellationToken* token)
+{
+    IOptimizer::setCancellation(token);
+    m_runner.setCancellation(token);
+    for (auto& chain : m_chains)
+        chain->ils->setCancellation(token);
+}
+
+long long IlsPoolOptimizer::chainSlice(int index, Clock::time_point deadline, int maxSteps)
+{
+    Chain& chain = *m_chains[index];
+    if (chain.restart.exchange(false, std::memory_order_relaxed))
+    {
+        std::vector<int> elite(m_scratch.size());
+        const double cost = m_elite.readElite(elite);
+        chain.ils->restartFrom(elite, cost);
+    }
+
+    const long long first = chain.ils->steps();
+    if (chain.ils->iterateBatch(maxSteps, deadline))
+        m_elite.offer(index, chain.ils->bestTour().order(), chain.ils->bestCost());
+
+    const long long kicks = chain.ils->steps() - first;
+    chain.kicks.fetch_add(kicks, std::memory_order_relaxed);
+    chain.currentCost.store(chain.ils->currentCost(), std::memory_order_relaxed);
+    return kicks;
+}
+
+void IlsPoolOptimizer::restartWorst()
+{
+    const int chains = static_cast<int>(m_chains.size());
+    const int count = std::min(chains - 1, static_cast<int>(std::lround(m_restartFraction * chains)));
+    if (count <= 0)
+        return;
+
+    // rank by the cost of the tour each chain is currently working on
+    std::vector<int> rank(static_cast<size_t>(chains));
+    for (int c = 0; c < chains; ++c) rank[c] = c;
+    std::sort(rank.begin(), rank.end(), [this](int a, int b)
+    {
+        return m_chains[a]->currentCost.load(std::memory_order_relaxed) > m_chains[b]->currentCost.load(std::memory_order_relaxed);
+    });
+
+    const int elite = m_elite.eliteSlot();
+    for (int t = 0; t < count; ++t)
+    {
+        if (rank[t] != elite)
+            m_chains[rank[t]]->restart.store(true, std::memory_order_relaxed);
+    }
+}
+
+std::vector<double> IlsPoolOptimizer::kicksPerSecond() const
+{
+    std::vector<double> out(m_chains.size(), 0.0);
+    const Clock::rep started = m_started.load(std::memory_order_acquire);
+    if (started == 0)
+        return out;
+
+    const double secs = std::chrono::duration<double>(Clock::now() - Clock::time_point(Clock::duration(started))).count();
+    if (secs <= 0.0)
+        return out;
+
+    for (size_t c = 0; c < m_chains.size(); ++c)
+        out[c] = static_cast<double>(m_chains[c]->kicks.load(std::memory_order_relaxed)) / secs;
+    return out;
+}
+
+bool IlsPoolOptimizer::iterate()
+{
+    return iterateBatch(1, Clock::now());
+}
+
+bool IlsPoolOptimizer::iterateBatch(int maxSteps, Clock::time_point deadline)
+{
+    const auto now = Clock::now();
+    if (m_started.load(std::memory_order_relaxed) == 0)
+    {
+        // before any chain runs, so every kick counts against this start
+        m_started.store(now.time_since_epoch().count(), std::memory_order_release);
+        m_lastRestart = now;
+    }
+    else if (now - m_lastRestart >= std::chrono::milliseconds(m_restartIntervalMs))
+    {
+        m_lastRestart = now;
+        restartWorst();
+    }
+
+    m_runner.run(m_steps + maxSteps, deadline);
+    m_steps = m_runner.steps();
+
+    const unsigned version = m_elite.version();
+    if (version == m_seenVersion)
+        return false;
+
+    m_seenVersion = version;
+    const double cost = m_elite.readElite(m_scratch);
+    if (!(cost < m_best.cost()))
+        return false;
+
+    m_best.order().assign(m_scratch.begin(), m_scratch.end());
+    m_best.setCost(cost);
+    return true;
+}
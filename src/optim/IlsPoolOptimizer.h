@@ -0,0 +1,70 @@
+#pragma once
+
+#include "IOptimizer.h"
+#include "EliteSnapshots.h"
+#include "IlsOptimizer.h"
+#include "SliceRunner.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <vector>
+
+// Multi-start ILS: N independent localized IlsOptimizer chains, run in slices on the shared
+// scheduler by a SliceRunner; a step is one kick of any chain. A chain that finds a new
+// global best leaves it in its EliteSnapshots slot. Every `restartIntervalMs` a batch flags
+// the worst `restartFraction` of the chains (by the cost of the tour they are working on);
+// their next slice continues from the elite tour. The facade only reports the global best,
+// like IslandGaOptimizer.
+class IlsPoolOptimizer final : public IOptimizer
+{
+public:
+    IlsPoolOptimizer(const Tour& initial,
+                     int chains = 0, // 0 = one per scheduler thread
+                     int threads = 0, // chains run at once; 0 = every scheduler thread
+                     IlsOptimizer::Acceptance acceptance = IlsOptimizer::Acceptance::Better,
+                     int restartIntervalMs = 2000,
+                     double restartFraction = 0.25,
+                     uint32_t seed = std::random_device{}());
+    ~IlsPoolOptimizer() override;
+
+    bool iterate() override;
+    bool iterateBatch(int maxSteps, Clock::time_point deadline) override;
+    const Tour& bestTour() const override { return m_best; }
+    double baselineCost() const override { return m_baseline; }
+    void setCancellation(const CancellationToken* token) override;
+
+    // Kicks per second of every chain since the first batch (zeros before it). Safe to
+    // call from any thread while the chains run.
+    std::vector<double> kicksPerSecond() const;
+
+private:
+    struct Chain
+    {
+        std::unique_ptr<IlsOptimizer> ils;
+        std::atomic<long long> kicks { 0 }; // since the first batch
+        std::atomic<double> currentCost { 0.0 };
+        std::atomic_bool restart { false }; // set by the facade, taken by the chain's next slice
+    };
+
+    long long chainSlice(int index, Clock::time_point deadline, int maxSteps);
+    void restartWorst();
+
+    std::vector<std::unique_ptr<Chain>> m_chains;
+
+    int m_restartIntervalMs = 2000;
+    double m_restartFraction = 0.25;
+
+    EliteSnapshots m_elite; // one slot per chain
+    unsigned m_seenVersion = 0;
+
+    std::atomic<Clock::rep> m_started { 0 }; // first batch, since the clock's epoch; 0 = not yet
+    Clock::time_point m_lastRestart;
+    std::vector<int> m_scratch;
+
+    Tour m_best;
+    double m_baseline = 0.0;
+
+    SliceRunner m_runner; // last: its slices use everything above
+};
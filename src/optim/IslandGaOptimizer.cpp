@@ -0,0 +1,131 @@
+#include "IslandGaOptimizer.h"
+
+#include <algorithm>
+
+namespace
+{
+    int islandCount(int islands)
+    {
+        return (islands > 0) ? islands : TaskScheduler::instance().size();
+    }
+}
+
+IslandGaOptimizer::IslandGaOptimizer(const Tour& initial,
+                                     int islands,
+                                     int threads,
+                                     int populationPerIsland,
+                                     int migrationInterval,
+                                     Topology topology,
+                                     CrossoverKind crossover,
+                                     bool localSearch,
+                                     uint32_t seed)
+: m_migrationInterval(std::max(1, migrationInterval)),
+  m_topology(topology),
+  m_globalCost(initial.cost()),
+  m_best(initial),
+  m_baseline(initial.cost()),
+  m_runner(islandCount(islands), threads,
+           [this](int index, Clock::time_point deadline, int maxSteps){ return islandSlice(index, deadline, maxSteps); })
+{
+    islands = islandCount(islands);
+
+    std::seed_seq seq{ seed };
+    std::vector<uint32_t> seeds(static_cast<size_t>(2 * islands));
+    seq.generate(seeds.begin(), seeds.end());
+
+    m_islands.resize(static_cast<size_t>(islands));
+    for (int i = 0; i < islands; ++i)
+    {
+        Island& isl = m_islands[i];
+        isl.ga = std::make_unique<GeneticOptimizer>(initial, populationPerIsland, 2, 1,
+                                                    crossover, localSearch, seeds[2 * i]);
+        isl.inbox = std::make_unique<BoundedQueue<std::vector<int>>>(8);
+        isl.rng.seed(seeds[2 * i + 1]);
+    }
+
+    m_globalOrder = initial.order();
+}
+
+IslandGaOptimizer::~IslandGaOptimizer()
+{
+    m_runner.stop();
+}
+
+void IslandGaOptimizer::setCancellation(const CancellationToken* token)
+{
+    IOptimizer::setCancellation(token);
+    m_runner.setCancellation(token);
+    for (auto& isl : m_islands)
+        isl.ga->setCancellation(token);
+}
+
+void IslandGaOptimizer::publish(const Tour& tour)
+{
+    // cheap reject without the lock
+    if (tour.cost() >= m_globalCost.load(std::memory_order_relaxed))
+        return;
+
+    std::lock_guard<std::mutex> lock(m_globalMutex);
+    if (tour.cost() >= m_globalCost.load(std::memory_order_relaxed))
+        return;
+
+    m_globalOrder.assign(tour.order().begin(), tour.order().end());
+    m_globalCost.store(tour.cost(), std::memory_order_relaxed);
+    m_globalVersion.fetch_add(1, std::memory_order_release);
+}
+
+long long IslandGaOptimizer::islandSlice(int index, Clock::time_point deadline, int maxSteps)
+{
+    Island& isl = m_islands[index];
+    const int islands = static_cast<int>(m_islands.size());
+    const long long first = isl.ga->steps();
+
+    std::vector<int> migrant;
+    do
+    {
+        // run up to the next migration; the generation count is the GA's step count
+        const int left = maxSteps - static_cast<int>(isl.ga->steps() - first);
+        const int due = m_migrationInterval - static_cast<int>(isl.ga->steps() % m_migrationInterval);
+        if (isl.ga->iterateBatch(std::min(due, left), deadline))
+            publish(isl.ga->bestTour());
+
+        if (isl.ga->steps() % m_migrationInterval != 0 || islands < 2)
+            continue;
+
+        // emigrate a copy of the elite
+        int target = (index + 1) % islands;
+        if (m_topology == Topology::Random)
+        {
+            target = std::uniform_int_distribution<int>(0, islands - 2)(isl.rng);
+            if (target >= index) ++target;
+        }
+        m_islands[target].inbox->tryPush(isl.ga->bestTour().order());
+
+        // immigrate whatever arrived
+        while (isl.inbox->tryPop(migrant))
+            isl.ga->immigrate(migrant);
+    }
+    while (isl.ga->steps() - first < maxSteps && Clock::now() < deadline && !cancelled());
+
+    return isl.ga->steps() - first;
+}
+
+bool IslandGaOptimizer::iterate()
+{
+    return iterateBatch(1, Clock::now());
+}
+
+bool IslandGaOptimizer::iterateBatch(int maxSteps, Clock::time_point deadline)
+{
+    m_runner.run(m_steps + maxSteps, deadline);
+    m_steps = m_runner.steps();
+
+    if (m_globalVersion.load(std::memory_order_acquire) == m_seenVersion)
+        return false;
+
+    std::lock_guard<std::mutex> lock(m_globalMutex);
+    m_best.order().assign(m_globalOrder.begin(), m_globalOrder.end());
+    m_best.setCost(m_globalCost.load(std::memory_order_relaxed));
+    m_seenVersion = m_globalVersion.load(std::memory_order_relaxed);
+    return true;
+}
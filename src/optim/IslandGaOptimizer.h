@@ -0,0 +1,69 @@
+#pragma once
+
+#include "IOptimizer.h"
+#include "BoundedQueue.h"
+#include "GeneticOptimizer.h"
+#include "SliceRunner.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <vector>
+
+// Island-model GA: N independent GeneticOptimizer populations, run in slices on the shared
+// scheduler by a SliceRunner. Every `migrationInterval` generations an island sends a copy
+// of its elite tour to a neighbor island (ring) or to a random one, through bounded
+// lock-free inboxes; full inboxes simply drop the migrant. A step is one generation of any
+// island, and the facade reports the global best, so it plugs into OptimizerWorker like any
+// single-threaded optimizer.
+class IslandGaOptimizer final : public IOptimizer
+{
+public:
+    enum class Topology { Ring, Random };
+
+    IslandGaOptimizer(const Tour& initial,
+                      int islands = 0, // 0 = one per scheduler thread
+                      int threads = 0, // islands run at once; 0 = every scheduler thread
+                      int populationPerIsland = 50,
+                      int migrationInterval = 25, // generations
+                      Topology topology = Topology::Ring,
+                      CrossoverKind crossover = CrossoverKind::EAX,
+                      bool localSearch = true,
+                      uint32_t seed = std::random_device{}());
+    ~IslandGaOptimizer() override;
+
+    bool iterate() override;
+    bool iterateBatch(int maxSteps, Clock::time_point deadline) override;
+    const Tour& bestTour() const override { return m_best; }
+    double baselineCost() const override { return m_baseline; }
+    void setCancellation(const CancellationToken* token) override;
+
+private:
+    struct Island
+    {
+        std::unique_ptr<GeneticOptimizer> ga;
+        std::unique_ptr<BoundedQueue<std::vector<int>>> inbox;
+        std::mt19937 rng; // migration targets
+    };
+
+    long long islandSlice(int index, Clock::time_point deadline, int maxSteps);
+    void publish(const Tour& tour);
+
+    std::vector<Island> m_islands;
+
+    int m_migrationInterval = 25;
+    Topology m_topology = Topology::Ring;
+
+    // global best, written by the islands
+    std::mutex m_globalMutex;
+    std::vector<int> m_globalOrder;
+    std::atomic<double> m_globalCost;
+    std::atomic<unsigned> m_globalVersion { 0 };
+    unsigned m_seenVersion = 0;
+
+    Tour m_best;
+    double m_baseline = 0.0;
+
+    SliceRunner m_runner; // last: its slices use everything above
+};
@@ -0,0 +1,282 @@
+#include "LocalSearch.h"
+
+#include <algorithm>
+
+static constexpr int kCancelCheckNodes = 256; // queue pops between cancellation checks
+
+static inline double dist(const std::vector<TspPoint>& pts, int a, int b)
+{
+    return Tour::edgeCost(pts[a], pts[b]);
+}
+
+// Delta of reversing positions [i..j] of an open tour (same formula as the optimizers use).
+static double deltaReverseOpen(const std::vector<TspPoint>& pts, const int* ord, int n, int i, int j)
+{
+    if (j - i < 1) return 0.0;
+    if (i == 0 && j == n - 1) return 0.0;
+
+    double delta = 0.0;
+    if (i > 0)
+        delta += dist(pts, ord[i - 1], ord[j]) - dist(pts, ord[i - 1], ord[i]);
+    if (j < n - 1)
+        delta += dist(pts, ord[i], ord[j + 1]) - dist(pts, ord[j], ord[j + 1]);
+    return delta;
+}
+
+TwoOptLocalSearch::TwoOptLocalSearch(const TspInstance* instance, const std::vector<int>* neighbors, int K, bool orOpt)
+: m_instance(instance),
+  m_neighbors(neighbors),
+  m_K(K),
+  m_n(instance ? instance->size() : 0),
+  m_orOpt(orOpt)
+{
+    m_pos.resize(static_cast<size_t>(m_n));
+    m_queue.resize(static_cast<size_t>(m_n));
+    m_queued.assign(static_cast<size_t>(m_n), 0);
+}
+
+void TwoOptLocalSearch::push(int node)
+{
+    if (m_queued[node]) return;
+    m_queued[node] = 1;
+    int tail = m_head + m_count;
+    if (tail >= m_n) tail -= m_n;
+    m_queue[tail] = node;
+    ++m_count;
+}
+
+void TwoOptLocalSearch::applyReversal(int* ord, int i, int j)
+{
+    // the four endpoints of the changed edges get their don't-look bits reset
+    push(ord[i]);
+    push(ord[j]);
+    if (i > 0) push(ord[i - 1]);
+    if (j < m_n - 1) push(ord[j + 1]);
+
+    std::reverse(ord + i, ord + j + 1);
+    for (int p = i; p <= j; ++p)
+        m_pos[ord[p]] = p;
+
+    if (m_observer)
+        m_observer(i, j);
+}
+
+void TwoOptLocalSearch::applyMove(int* ord, int i, int j, int t, bool reversed)
+{
+    // moves segment S = [i..j] right after position t (t < i-1 or t > j), optionally
+    // reversed. Done as reversals (block swap T S <-> S T), so the observer sees every change
+    // and the joints get their don't-look bits reset.
+    if (t > j)
+    {
+        // S T -> T S (or T S^r)
+        if (!reversed) rev(ord, i, j);
+        rev(ord, j + 1, t);
+        rev(ord, i, t);
+    }
+    else
+    {
+        // T S -> S T (or S^r T)
+        rev(ord, t + 1, i - 1);
+        if (!reversed) rev(ord, i, j);
+        rev(ord, t + 1, j);
+    }
+}
+
+double TwoOptLocalSearch::tryOrOpt(int* ord, int a)
+{
+    const auto& pts = m_instance->points();
+    const int p = m_pos[a];
+
+    // segments of 1..3 nodes starting or ending at a
+    for (int len = 1; len <= 3; ++len)
+    {
+        for (int side = 0; side < (len == 1 ? 1 : 2); ++side)
+        {
+            const int i = (side == 0) ? p : p - len + 1;
+            const int j = i + len - 1;
+            if (i < 0 || j >= m_n || len >= m_n - 1) continue;
+
+            const int s0 = ord[i], s1 = ord[j];
+            const int prev = (i > 0) ? ord[i - 1] : -1;
+            const int next = (j < m_n - 1) ? ord[j + 1] : -1;
+
+            // cost saved by cutting the segment out
+            double removeGain = 0.0;
+            if (prev >= 0) removeGain += dist(pts, prev, s0);
+            if (next >= 0) removeGain += dist(pts, s1, next);
+            if (prev >= 0 && next >= 0) removeGain -= dist(pts, prev, next);
+            if (removeGain <= 1e-9) continue;
+
+            for (int end = 0; end < 2; ++end)
+            {
+                const int e = end ? s1 : s0;
+                const int* nb = m_neighbors->data() + static_cast<size_t>(e) * static_cast<size_t>(m_K);
+                for (int k = 0; k < m_K; ++k)
+                {
+                    const int c = nb[k];
+                    if (dist(pts, e, c) >= removeGain) break;
+
+                    const int q = m_pos[c];
+                    if (q >= i && q <= j) continue;
+
+                    // insert after q or before q (= after q-1)
+                    for (int t = q - 1; t <= q; ++t)
+                    {
+                        if (t >= i - 1 && t <= j) continue; // touches the segment / original place
+                        const int left = (t >= 0) ? ord[t] : -1;
+                        const int right = (t + 1 < m_n) ? ord[t + 1] : -1;
+
+                        double base = 0.0;
+                        if (left >= 0 && right >= 0) base = dist(pts, left, right);
+
+                        for (int rev = 0; rev < 2; ++rev)
+                        {
+                            const int x = rev ? s1 : s0; // joins left
+                            const int y = rev ? s0 : s1; // joins right
+                            double add = -base;
+                            if (left >= 0) add += dist(pts, left, x);
+                            if (right >= 0) add += dist(pts, y, right);
+
+                            const double delta = add - removeGain;
+                            if (delta < -1e-9)
+                            {
+                                applyMove(ord, i, j, t, rev != 0);
+                                return delta;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return 0.0;
+}
+
+double TwoOptLocalSearch::tryNode(int* ord, int a)
+{
+    const auto& pts = m_instance->points();
+    const int* nb = m_neighbors->data() + static_cast<size_t>(a) * static_cast<size_t>(m_K);
+
+    const int p = m_pos[a];
+    const double dSucc = (p < m_n - 1) ? dist(pts, a, ord[p + 1]) : 0.0;
+    const double dPred = (p > 0) ? dist(pts, a, ord[p - 1]) : 0.0;
+
+    for (int k = 0; k < m_K; ++k)
+    {
+        const int c = nb[k];
+        const double dac = dist(pts, a, c);
+        if (dac >= dSucc && dac >= dPred)
+            break; // neighbors are sorted: no later candidate can give a positive first gain
+
+        const int q = m_pos[c];
+
+        // connect a-c, dropping a's successor edge
+        if (dac < dSucc)
+        {
+            const int i = (q > p) ? p + 1 : q + 1;
+            const int j = (q > p) ? q : p;
+            if (j - i >= 1)
+            {
+                const double delta = deltaReverseOpen(pts, ord, m_n, i, j);
+                if (delta < -1e-9)
+                {
+                    applyReversal(ord, i, j);
+                    return delta;
+                }
+            }
+        }
+
+        // connect a-c, dropping a's predecessor edge
+        if (dac < dPred)
+        {
+            const int i = (q < p) ? q : p;
+            const int j = (q < p) ? p - 1 : q - 1;
+            if (j - i >= 1)
+            {
+                const double delta = deltaReverseOpen(pts, ord, m_n, i, j);
+                if (delta < -1e-9)
+                {
+                    applyReversal(ord, i, j);
+                    return delta;
+                }
+            }
+        }
+    }
+    return 0.0;
+}
+
+void TwoOptLocalSearch::attach(const int* ord)
+{
+    m_head = 0;
+    m_count = 0;
+    std::fill(m_queued.begin(), m_queued.end(), 0);
+    for (int p = 0; p < m_n; ++p)
+        m_pos[ord[p]] = p;
+}
+
+double TwoOptLocalSearch::optimize(int* ord)
+{
+    if (!m_instance || m_n < 4 || m_K <= 0) return 0.0;
+
+    attach(ord);
+    for (int p = 0; p < m_n; ++p)
+        push(ord[p]);
+
+    return improve(ord);
+}
+
+double TwoOptLocalSearch::optimizeChanged(int* ord, const int* reference)
+{
+    if (!m_instance || m_n < 4 || m_K <= 0) return 0.0;
+
+    // compare every node's neighbors against the reference's (m_pos indexes it here)
+    attach(reference);
+    for (int p = 0; p < m_n; ++p)
+    {
+        const int v = ord[p];
+        const int a = (p > 0) ? ord[p - 1] : -1;
+        const int b = (p < m_n - 1) ? ord[p + 1] : -1;
+        const int q = m_pos[v];
+        const int c = (q > 0) ? reference[q - 1] : -1;
+        const int d = (q < m_n - 1) ? reference[q + 1] : -1;
+        if (!((a == c && b == d) || (a == d && b == c)))
+            push(v);
+    }
+
+    for (int p = 0; p < m_n; ++p)
+        m_pos[ord[p]] = p;
+    return improve(ord);
+}
+
+double TwoOptLocalSearch::improve(int* ord)
+{
+    if (!m_instance || m_n < 4 || m_K <= 0) return 0.0;
+
+    double total = 0.0;
+    int untilCheck = kCancelCheckNodes;
+    while (m_count > 0)
+    {
+        if (--untilCheck == 0)
+        {
+            if (m_cancel && m_cancel->cancelled())
+                break;
+            untilCheck = kCancelCheckNodes;
+        }
+
+        const int a = m_queue[m_head];
+        if (++m_head >= m_n) m_head = 0;
+        --m_count;
+        m_queued[a] = 0;
+
+        // keep working on a node while it improves
+        for (;;)
+        {
+            double d = tryNode(ord, a);
+            if (d >= 0.0 && m_orOpt)
+                d = tryOrOpt(ord, a);
+            if (d >= 0.0) break;
+            total += d;
+        }
+    }
+    return total;
+}
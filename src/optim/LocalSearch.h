@@ -0,0 +1,65 @@
+#pragma once
+
+#include "../Tour.h"
+#include "../CancellationToken.h"
+#include <functional>
+#include <vector>
+
+// Neighbor-list 2-opt (plus optional or-opt) with don't-look bits for open tours
+// stored as plain int arrays.
+// Only moves that connect a node to one of its K nearest neighbors are examined,
+// and only nodes whose adjacent edges changed are re-examined, so a pass over an
+// already good tour costs roughly O(n * K) plus the reversals actually applied.
+// One instance per thread: it owns the position array and the work queue.
+class TwoOptLocalSearch
+{
+public:
+    TwoOptLocalSearch(const TspInstance* instance, const std::vector<int>* neighbors, int K,
+                      bool orOpt = false); // also move segments of 1..3 nodes next to a neighbor
+
+    // Improve ord[0..n) in place until no improving neighbor move is left.
+    // Returns the (non-positive) change of the tour cost.
+    double optimize(int* ord);
+
+    // Same, for a tour derived from the locally optimal `reference` (a GA offspring and
+    // its parent): only the nodes whose tour neighbors differ from it start in the queue.
+    double optimizeChanged(int* ord, const int* reference);
+
+    // Incremental use (ILS): attach() indexes the positions of ord once; afterwards every
+    // change to ord goes through reverse(), which keeps the index current and resets the
+    // don't-look bits of the endpoints only, and improve() works off those nodes alone.
+    void attach(const int* ord);
+    void reverse(int* ord, int i, int j) { applyReversal(ord, i, j); }
+    double improve(int* ord);
+    int position(int node) const { return m_pos[node]; }
+
+    // Called after every reversal [i..j] of ord (all moves, or-opt included, are reversals).
+    void setReversalObserver(std::function<void(int, int)> observer) { m_observer = std::move(observer); }
+
+    // improve() polls the token every few hundred nodes and returns early once it is
+    // cancelled; the tour is left valid, just not locally optimal.
+    void setCancellation(const CancellationToken* token) { m_cancel = token; }
+
+private:
+    double tryNode(int* ord, int a);
+    double tryOrOpt(int* ord, int a);
+    void applyReversal(int* ord, int i, int j);
+    void applyMove(int* ord, int i, int j, int t, bool reversed);
+    void rev(int* ord, int i, int j) { if (j > i) applyReversal(ord, i, j); }
+    void push(int node);
+
+    const TspInstance* m_instance = nullptr;
+    const std::vector<int>* m_neighbors = nullptr;
+    int m_K = 0;
+    int m_n = 0;
+    bool m_orOpt = false;
+
+    std::vector<int> m_pos;     // node -> position in ord
+    std::vector<int> m_queue;   // ring buffer of nodes to (re)examine
+    std::vector<char> m_queued;
+    int m_head = 0;
+    int m_count = 0;
+
+    std::function<void(int, int)> m_observer;
+    const CancellationToken* m_cancel = nullptr;
+};
@@ -0,0 +1,244 @@
+#include "OptimizerFactory.h"
+
+#include "AcoOptimizer.h"
+#include "ArqOptimizer.h"
+#include "GeneticOptimizer.h"
+#include "IlsOptimizer.h"
+#include "IlsPoolOptimizer.h"
+#include "IslandGaOptimizer.h"
+#include "PortfolioOptimizer.h"
+#include "SimAnnealOptimizer.h"
+#include "TwoOptOptimizer.h"
+
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+// EAX population of ga-eax and the portfolio's GA: the best quality per CPU-second on
+// gr9882 among 12, 30 and 100 (larger ones spend most of a run seeding)
+static constexpr int kEaxPopulation = 12;
+
+const std::string* OptimizerParams::find(const std::string& key) const
+{
+    const auto it = m_values.find(key);
+    if (it == m_values.end())
+        return nullptr;
+    m_used.insert(key);
+    return &it->second;
+}
+
+int OptimizerParams::getInt(const std::string& key, int fallback) const
+{
+    const std::string* v = find(key);
+    if (!v) return fallback;
+
+    size_t end = 0;
+    int value = 0;
+    try { value = std::stoi(*v, &end); }
+    catch (const std::exception&) { end = 0; }
+    if (end == 0 || end != v->size())
+        throw std::invalid_argument("parameter " + key + ": not an integer: " + *v);
+    return value;
+}
+
+double OptimizerParams::getDouble(const std::string& key, double fallback) const
+{
+    const std::string* v = find(key);
+    if (!v) return fallback;
+
+    size_t end = 0;
+    double value = 0.0;
+    try { value = std::stod(*v, &end); }
+    catch (const std::exception&) { end = 0; }
+    if (end == 0 || end != v->size())
+        throw std::invalid_argument("parameter " + key + ": not a number: " + *v);
+    return value;
+}
+
+uint32_t OptimizerParams::getSeed() const
+{
+    const std::string* v = find("seed");
+    if (!v) return std::random_device{}();
+
+    size_t end = 0;
+    unsigned long value = 0;
+    try { value = std::stoul(*v, &end); }
+    catch (const std::exception&) { end = 0; }
+    if (end == 0 || end != v->size())
+        throw std::invalid_argument("parameter seed: not an unsigned integer: " + *v);
+    return static_cast<uint32_t>(value);
+}
+
+std::string OptimizerParams::getString(const std::string& key, const std::string& fallback) const
+{
+    const std::string* v = find(key);
+    return v ? *v : fallback;
+}
+
+std::vector<std::string> OptimizerParams::unused() const
+{
+    std::vector<std::string> out;
+    for (const auto& kv : m_values)
+    {
+        if (!m_used.count(kv.first))
+            out.push_back(kv.first);
+    }
+    return out;
+}
+
+const std::vector<OptimizerPreset>& optimizerPresets()
+{
+    static const std::vector<OptimizerPreset> presets = {
+        { "ga",          "Genetic Algorithm (GA)",                                  "population mutation threads" },
+        { "sa",          "Simulated Annealing (SA)",                                "alpha" },
+        { "2opt",        "2-opt Local Search",                                      "checks" },
+        { "ils",         "Iterated Local Search (ILS)",                             "checks stagnation acceptance" },
+        { "ga-parallel", "Genetic Algorithm - parallel (GA, pop 256)",              "population mutation threads" },
+        { "ga-eax",      "Genetic Algorithm - EAX + 2-opt (GA)",                    "population mutation threads" },
+        { "ga-erx",      "Genetic Algorithm - edge recombination + 2-opt (GA)",     "population mutation threads" },
+        { "ga-ox",       "Genetic Algorithm - order crossover + 2-opt (GA)",        "population mutation threads" },
+        { "island",      "Genetic Algorithm - island model (GA, EAX, all cores)",   "islands threads population migration topology" },
+        { "aco",         "Ant Colony Optimization (ACO)",                           "ants k samples alpha beta rho q threads" },
+        { "mmas",        "MAX-MIN Ant System + 2-opt/or-opt (ACO, all cores)",      "ants k samples alpha beta rho q threads" },
+        { "arq",         "ARQ - adaptive permutation DE (JADE-style, all cores)",   "population threads" },
+        { "ils-pool",    "Iterated Local Search - multi-start pool (ILS, all cores)", "chains threads acceptance restart-ms restart-fraction" },
+        { "portfolio",   "Portfolio - SA + ILS + GA + MMAS (all cores)",             "stagnation-ms threads" },
+    };
+    return presets;
+}
+
+const OptimizerPreset* findPreset(const std::string& name)
+{
+    for (const OptimizerPreset& p : optimizerPresets())
+    {
+        if (name == p.name)
+            return &p;
+    }
+    return nullptr;
+}
+
+bool presetReads(const OptimizerPreset& preset, const std::string& key)
+{
+    if (key == "seed")
+        return true;
+
+    std::istringstream keys(preset.params);
+    std::string k;
+    while (keys >> k)
+    {
+        if (k == key)
+            return true;
+    }
+    return false;
+}
+
+namespace
+{
+    IlsOptimizer::Acceptance parseAcceptance(const std::string& s)
+    {
+        if (s == "better") return IlsOptimizer::Acceptance::Better;
+        if (s == "walk")   return IlsOptimizer::Acceptance::RandomWalk;
+        if (s == "restart") return IlsOptimizer::Acceptance::Restart;
+        throw std::invalid_argument("parameter acceptance: expected better, walk or restart: " + s);
+    }
+
+    IslandGaOptimizer::Topology parseTopology(const std::string& s)
+    {
+        if (s == "ring")   return IslandGaOptimizer::Topology::Ring;
+        if (s == "random") return IslandGaOptimizer::Topology::Random;
+        throw std::invalid_argument("parameter topology: expected ring or random: " + s);
+    }
+
+    std::unique_ptr<IOptimizer> makeGa(const Tour& initial, const OptimizerParams& p,
+                                       int population, int threads, CrossoverKind crossover, bool localSearch)
+    {
+        return std::make_unique<GeneticOptimizer>(initial,
+                                                  p.getInt("population", population),
+                                                  p.getInt("mutation", 2),
+                                                  p.getInt("threads", threads),
+                                                  crossover, localSearch, p.getSeed());
+    }
+
+    std::unique_ptr<IOptimizer> makeAco(const Tour& initial, const OptimizerParams& p,
+                                        double beta, double rho, AcoOptimizer::Variant variant, bool localSearch)
+    {
+        return std::make_unique<AcoOptimizer>(initial,
+                                              p.getInt("ants", 20),
+                                              p.getInt("k", 20),
+                                              p.getInt("samples", 200),
+                                              p.getDouble("alpha", 1.0),
+                                              p.getDouble("beta", beta),
+                                              p.getDouble("rho", rho),
+                                              p.getDouble("q", 1.0),
+                                              p.getInt("threads", 0),
+                                              variant, localSearch, p.getSeed());
+    }
+}
+
+std::unique_ptr<IOptimizer> makeOptimizer(const std::string& name,
+                                          const Tour& initial,
+                                          const OptimizerParams& p)
+{
+    if (name == "ga")          return makeGa(initial, p, 30, 1, CrossoverKind::None, false);
+    if (name == "ga-parallel") return makeGa(initial, p, 256, 0, CrossoverKind::None, false);
+    if (name == "ga-eax")      return makeGa(initial, p, kEaxPopulation, 0, CrossoverKind::EAX, true);
+    if (name == "ga-erx")      return makeGa(initial, p, 100, 0, CrossoverKind::ERX, true);
+    if (name == "ga-ox")       return makeGa(initial, p, 100, 0, CrossoverKind::OX, true);
+
+    if (name == "sa")
+        return std::make_unique<SimAnnealOptimizer>(initial, p.getSeed(), p.getDouble("alpha", 0.999995));
+    if (name == "2opt")
+        return std::make_unique<TwoOptOptimizer>(initial, p.getInt("checks", 4000), p.getSeed());
+    if (name == "ils")
+        return std::make_unique<IlsOptimizer>(initial,
+                                              p.getInt("checks", 2500),
+                                              p.getInt("stagnation", 150),
+                                              true,
+                                              parseAcceptance(p.getString("acceptance", "better")),
+                                              p.getSeed());
+
+    if (name == "island")
+        return std::make_unique<IslandGaOptimizer>(initial,
+                                                   p.getInt("islands", 0),
+                                                   p.getInt("threads", 0),
+                                                   p.getInt("population", 50),
+                                                   p.getInt("migration", 25),
+                                                   parseTopology(p.getString("topology", "ring")),
+                                                   CrossoverKind::EAX, true, p.getSeed());
+
+    if (name == "aco")  return makeAco(initial, p, 3.0, 0.10, AcoOptimizer::Variant::AntSystem, false);
+    if (name == "mmas") return makeAco(initial, p, 2.0, 0.20, AcoOptimizer::Variant::MaxMin, true);
+
+    if (name == "arq")
+        return std::make_unique<ArqOptimizer>(initial, p.getInt("population", 64), p.getInt("threads", 0), true, p.getSeed());
+
+    if (name == "ils-pool")
+        return std::make_unique<IlsPoolOptimizer>(initial,
+                                                  p.getInt("chains", 0),
+                                                  p.getInt("threads", 0),
+                                                  parseAcceptance(p.getString("acceptance", "better")),
+                                                  p.getInt("restart-ms", 2000),
+                                                  p.getDouble("restart-fraction", 0.25),
+                                                  p.getSeed());
+
+    if (name == "portfolio")
+    {
+        // one seed per member, all derived from the portfolio's
+        std::seed_seq seq{ p.getSeed() };
+        uint32_t seeds[4];
+        seq.generate(seeds, seeds + 4);
+
+        std::vector<PortfolioOptimizer::Member> members;
+        members.push_back({ "SA", std::make_unique<SimAnnealOptimizer>(initial, seeds[0]) });
+        members.push_back({ "ILS", std::make_unique<IlsOptimizer>(initial, 2500, 150, true,
+                                                                  IlsOptimizer::Acceptance::Better, seeds[1]) });
+        members.push_back({ "GA", std::make_unique<GeneticOptimizer>(initial, kEaxPopulation, 2, 1, CrossoverKind::EAX, true, seeds[2]) });
+        members.push_back({ "MMAS", std::make_unique<AcoOptimizer>(initial, 20, 20, 200, 1.0, 2.0, 0.20, 1.0, 1,
+                                                                   AcoOptimizer::Variant::MaxMin, true, seeds[3]) });
+        return std::make_unique<PortfolioOptimizer>(initial, std::move(members),
+                                                    p.getInt("stagnation-ms", 3000),
+                                                    p.getInt("threads", 0));
+    }
+
+    throw std::invalid_argument("unknown method: " + name);
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "IOptimizer.h"
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+// Optional key=value settings for an optimizer preset. Missing keys take the preset's
+// value; the getters throw std::invalid_argument on values that do not parse.
+class OptimizerParams
+{
+public:
+    void set(const std::string& key, const std::string& value) { m_values[key] = value; }
+    bool has(const std::string& key) const { return m_values.count(key) != 0; }
+
+    int getInt(const std::string& key, int fallback) const;
+    double getDouble(const std::string& key, double fallback) const;
+    uint32_t getSeed() const; // "seed", random if unset
+    std::string getString(const std::string& key, const std::string& fallback) const;
+
+    // keys that were set but never read; a typo in a parameter shows up here
+    std::vector<std::string> unused() const;
+
+private:
+    const std::string* find(const std::string& key) const;
+
+    std::map<std::string, std::string> m_values;
+    mutable std::set<std::string> m_used;
+};
+
+// A named optimizer configuration. The GUI lists the presets in this order.
+struct OptimizerPreset
+{
+    const char* name;        // short name for the command line
+    const char* description; // GUI label
+    const char* params;      // the keys it reads, besides "seed"
+};
+
+const std::vector<OptimizerPreset>& optimizerPresets();
+const OptimizerPreset* findPreset(const std::string& name); // null if unknown
+
+// true if the preset reads parameter `key`
+bool presetReads(const OptimizerPreset& preset, const std::string& key);
+
+// Builds the preset `name` starting from `initial`. Throws std::invalid_argument for an
+// unknown name or a bad parameter value.
+std::unique_ptr<IOptimizer> makeOptimizer(const std::string& name,
+                                          const Tour& initial,
+                                          const OptimizerParams& params = {});
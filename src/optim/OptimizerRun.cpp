@@ -0,0 +1,42 @@
+#include "OptimizerRun.h"
+
+#include <algorithm>
+#include <limits>
+
+RunResult runOptimizer(IOptimizer& optimizer,
+                       const TerminationCriteria& criteria,
+                       const CancellationToken* cancel,
+                       std::chrono::milliseconds slice,
+                       const std::function<void(bool improved)>& afterSlice)
+{
+    RunResult result;
+    result.initialCost = optimizer.bestTour().cost();
+
+    const long long firstStep = optimizer.steps();
+    TerminationMonitor monitor(criteria, result.initialCost);
+
+    TerminationReason reason = TerminationReason::None;
+    while (!(cancel && cancel->cancelled()))
+    {
+        // long steps inside the slice poll the cancellation token
+        const auto deadline = IOptimizer::Clock::now() + slice;
+        const long long budget = monitor.stepBudget(optimizer.steps() - firstStep);
+        const int maxSteps = static_cast<int>(std::min<long long>(budget, std::numeric_limits<int>::max()));
+        const bool improved = optimizer.iterateBatch(maxSteps, deadline);
+
+        if (afterSlice)
+            afterSlice(improved);
+
+        reason = monitor.check(optimizer.steps() - firstStep, optimizer.bestTour().cost());
+        if (reason != TerminationReason::None)
+            break;
+    }
+
+    result.reason = (reason != TerminationReason::None) ? reason : TerminationReason::Cancelled;
+    result.bestCost = optimizer.bestTour().cost();
+    result.seconds = monitor.elapsedSeconds();
+    result.secondsToBest = monitor.secondsToBest();
+    result.steps = optimizer.steps() - firstStep;
+    result.stepsToBest = monitor.stepsToBest();
+    return result;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "IOptimizer.h"
+#include "TerminationCriteria.h"
+
+#include <chrono>
+#include <functional>
+
+// Outcome of one run driven by runOptimizer().
+struct RunResult
+{
+    TerminationReason reason = TerminationReason::None;
+    double initialCost = 0.0;
+    double bestCost = 0.0;
+    double seconds = 0.0;        // wall-clock time of the run
+    double secondsToBest = 0.0;  // when the final best was found
+    long long steps = 0;         // optimizer steps, see IOptimizer::steps()
+    long long stepsToBest = 0;
+};
+
+// Runs `optimizer` in time slices of `slice` until one of `criteria` holds or `cancel`
+// fires (reason Cancelled). Batches are cut short where a step criterion is due, so those
+// fire on the exact step. `afterSlice(improved)` runs on the calling thread after every
+// slice, e.g. to publish the best tour. The GUI worker and the command-line tools share
+// this loop; the caller wires `cancel` into the optimizer with setCancellation().
+RunResult runOptimizer(IOptimizer& optimizer,
+                       const TerminationCriteria& criteria,
+                       const CancellationToken* cancel,
+                       std::chrono::milliseconds slice,
+                       const std::function<void(bool improved)>& afterSlice = {});
@@ -0,0 +1,143 @@
+#include "PortfolioOptimizer.h"
+
+#include <algorithm>
+
+namespace
+{
+    int childCount(const std::vector<PortfolioOptimizer::Member>& members)
+    {
+        return static_cast<int>(std::count_if(members.begin(), members.end(),
+                                              [](const PortfolioOptimizer::Member& m){ return m.optimizer != nullptr; }));
+    }
+}
+
+PortfolioOptimizer::PortfolioOptimizer(const Tour& initial,
+                                       std::vector<Member> members,
+                                       int stagnationMs,
+                                       int threads)
+: m_stagnation(std::max(1, stagnationMs)),
+  m_elite(childCount(members), initial.order(), initial.cost()),
+  m_best(initial),
+  m_baseline(initial.cost()),
+  m_runner(childCount(members), threads,
+           [this](int index, Clock::time_point deadline, int maxSteps){ return childSlice(index, deadline, maxSteps); })
+{
+    const int n = initial.size();
+    m_children.reserve(members.size());
+    for (Member& m : members)
+    {
+        if (!m.optimizer)
+            continue;
+
+        auto child = std::make_unique<Child>();
+        child->name = std::move(m.name);
+        child->optimizer = std::move(m.optimizer);
+        child->bestCost.store(initial.cost(), std::memory_order_relaxed);
+        m_children.push_back(std::move(child));
+    }
+
+    m_scratch.resize(static_cast<size_t>(n));
+}
+
+PortfolioOptimizer::~PortfolioOptimizer()
+{
+    m_runner.stop();
+}
+
+void PortfolioOptimizer::setCancellation(const CancellationToken* token)
+{
+    IOptimizer::setCancellation(token);
+    m_runner.setCancellation(token);
+    for (auto& child : m_children)
+        child->optimizer->setCancellation(token);
+}
+
+void PortfolioOptimizer::publish(int index)
+{
+    Child& child = *m_children[index];
+    const Tour& best = child.optimizer->bestTour();
+    child.bestCost.store(best.cost(), std::memory_order_relaxed);
+
+    double previous = 0.0;
+    if (!m_elite.offer(index, best.order(), best.cost(), &previous))
+        return;
+
+    // the counters have a single writer at a time, so load + store is enough
+    child.globalBests.store(child.globalBests.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    child.gain.store(child.gain.load(std::memory_order_relaxed) + (previous - best.cost()), std::memory_order_relaxed);
+}
+
+long long PortfolioOptimizer::childSlice(int index, Clock::time_point deadline, int maxSteps)
+{
+    Child& child = *m_children[index];
+    const auto start = Clock::now();
+    const long long first = child.optimizer->steps();
+
+    const bool improved = child.optimizer->iterateBatch(maxSteps, deadline);
+    child.batches.fetch_add(1, std::memory_order_relaxed);
+    child.active += Clock::now() - start;
+    if (improved)
+    {
+        publish(index);
+        child.improvedAt = child.active;
+    }
+
+    // stagnated and behind: continue from the elite
+    if (child.active - child.improvedAt >= m_stagnation)
+    {
+        child.improvedAt = child.active;
+        if (m_elite.globalCost() < child.bestCost.load(std::memory_order_relaxed))
+        {
+            std::vector<int> elite(m_scratch.size());
+            const double cost = m_elite.readElite(elite);
+            if (child.optimizer->inject(elite, cost))
+            {
+                child.injections.fetch_add(1, std::memory_order_relaxed);
+                child.bestCost.store(std::min(cost, child.bestCost.load(std::memory_order_relaxed)), std::memory_order_relaxed);
+            }
+        }
+    }
+
+    return child.optimizer->steps() - first;
+}
+
+std::vector<PortfolioOptimizer::ChildStats> PortfolioOptimizer::stats() const
+{
+    std::vector<ChildStats> out(m_children.size());
+    for (size_t c = 0; c < m_children.size(); ++c)
+    {
+        const Child& child = *m_children[c];
+        ChildStats& s = out[c];
+        s.name = child.name;
+        s.bestCost = child.bestCost.load(std::memory_order_relaxed);
+        s.batches = child.batches.load(std::memory_order_relaxed);
+        s.globalBests = child.globalBests.load(std::memory_order_relaxed);
+        s.gain = child.gain.load(std::memory_order_relaxed);
+        s.injections = child.injections.load(std::memory_order_relaxed);
+    }
+    return out;
+}
+
+bool PortfolioOptimizer::iterate()
+{
+    return iterateBatch(1, Clock::now());
+}
+
+bool PortfolioOptimizer::iterateBatch(int maxSteps, Clock::time_point deadline)
+{
+    m_runner.run(m_steps + maxSteps, deadline);
+    m_steps = m_runner.steps();
+
+    const unsigned version = m_elite.version();
+    if (version == m_seenVersion)
+        return false;
+
+    m_seenVersion = version;
+    const double cost = m_elite.readElite(m_scratch);
+    if (!(cost < m_best.cost()))
+        return false;
+
+    m_best.order().assign(m_scratch.begin(), m_scratch.end());
+    m_best.setCost(cost);
+    return true;
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "IOptimizer.h"
+#include "EliteSnapshots.h"
+#include "SliceRunner.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Portfolio of different optimizers on the same instance, run in slices on the shared
+// scheduler by a SliceRunner; a step is one step of any child. A child whose batch beats
+// the global best leaves its tour in its EliteSnapshots slot and is credited with the
+// gain. A child that has not improved for `stagnationMs` of its own run time while
+// trailing the global best is handed the elite tour through IOptimizer::inject(). The
+// facade only reports the global best.
+class PortfolioOptimizer final : public IOptimizer
+{
+public:
+    struct Member
+    {
+        std::string name;
+        std::unique_ptr<IOptimizer> optimizer;
+    };
+
+    // Per-child counters; stats() may be called from any thread while the children run.
+    struct ChildStats
+    {
+        std::string name;
+        double bestCost = 0.0;   // the child's own best
+        long long batches = 0;   // iterateBatch() calls
+        int globalBests = 0;     // times the child set a new global best
+        double gain = 0.0;       // global cost reduction credited to the child
+        int injections = 0;      // elite tours handed to the child
+    };
+
+    PortfolioOptimizer(const Tour& initial,
+                       std::vector<Member> members,
+                       int stagnationMs = 3000,
+                       int threads = 0); // children run at once; 0 = every scheduler thread
+    ~PortfolioOptimizer() override;
+
+    bool iterate() override;
+    bool iterateBatch(int maxSteps, Clock::time_point deadline) override;
+    const Tour& bestTour() const override { return m_best; }
+    double baselineCost() const override { return m_baseline; }
+    void setCancellation(const CancellationToken* token) override;
+
+    std::vector<ChildStats> stats() const;
+
+private:
+    struct Child
+    {
+        std::string name;
+        std::unique_ptr<IOptimizer> optimizer;
+
+        std::atomic<double> bestCost { 0.0 };
+        std::atomic<long long> batches { 0 };
+        std::atomic<int> globalBests { 0 };
+        std::atomic<double> gain { 0.0 };
+        std::atomic<int> injections { 0 };
+
+        // time the child has run, and when it last improved; touched by its slices only
+        Clock::duration active { 0 };
+        Clock::duration improvedAt { 0 };
+    };
+
+    long long childSlice(int index, Clock::time_point deadline, int maxSteps);
+    void publish(int index);
+
+    std::vector<std::unique_ptr<Child>> m_children;
+
+    std::chrono::milliseconds m_stagnation;
+
+    EliteSnapshots m_elite; // one slot per child
+    unsigned m_seenVersion = 0;
+    std::vector<int> m_scratch;
+
+    Tour m_best;
+    double m_baseline = 0.0;
+
+    SliceRunner m_runner; // last: its slices use everything above
+};
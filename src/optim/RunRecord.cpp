@@ -0,0 +1,170 @@
+#include "RunRecord.h"
+
+#include <cstdio>
+#include <fstream>
+
+namespace
+{
+    void appendString(std::string& out, const std::string& s)
+    {
+        out += '"';
+        for (const char c : s)
+        {
+            switch (c)
+            {
+                case '"':  out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\n': out += "\\n"; break;
+                case '\r': out += "\\r"; break;
+                case '\t': out += "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20)
+                    {
+                        char buf[8];
+                        std::snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(static_cast<unsigned char>(c)));
+                        out += buf;
+                    }
+                    else
+                    {
+                        out += c;
+                    }
+            }
+        }
+        out += '"';
+    }
+
+    void appendNumber(std::string& out, double v, const char* format)
+    {
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), format, v);
+        out += buf;
+    }
+
+    void appendKey(std::string& out, const char* key)
+    {
+        if (out.size() > 1) out += ',';
+        out += '"';
+        out += key;
+        out += "\":";
+    }
+}
+
+std::string toJsonLine(const RunRecord& r)
+{
+    if (!r.error.empty())
+    {
+        std::string out = "{";
+        appendKey(out, "instance");    appendString(out, r.instance);
+        appendKey(out, "method");      appendString(out, r.method);
+        appendKey(out, "error");       appendString(out, r.error);
+        out += '}';
+        return out;
+    }
+
+    const RunResult& res = r.result;
+    const double improvement = (res.initialCost > 0.0) ? (res.initialCost - res.bestCost) / res.initialCost * 100.0 : 0.0;
+
+    std::string out = "{";
+    appendKey(out, "instance");        appendString(out, r.instance);
+    appendKey(out, "name");            appendString(out, r.name);
+    appendKey(out, "cities");          out += std::to_string(r.cities);
+    appendKey(out, "method");          appendString(out, r.method);
+    appendKey(out, "seed");            out += std::to_string(r.seed);
+    appendKey(out, "initial_cost");    appendNumber(out, res.initialCost, "%.17g");
+    appendKey(out, "best_cost");       appendNumber(out, res.bestCost, "%.17g");
+    appendKey(out, "improvement_percent"); appendNumber(out, improvement, "%.4f");
+    appendKey(out, "seconds");         appendNumber(out, res.seconds, "%.3f");
+    appendKey(out, "seconds_to_best"); appendNumber(out, res.secondsToBest, "%.3f");
+    appendKey(out, "steps");           out += std::to_string(res.steps);
+    appendKey(out, "steps_to_best");   out += std::to_string(res.stepsToBest);
+    appendKey(out, "termination");     appendString(out, terminationReasonName(res.reason));
+    if (!r.kicksPerSecond.empty())
+    {
+        appendKey(out, "kicks_per_second");
+        out += '[';
+        for (size_t c = 0; c < r.kicksPerSecond.size(); ++c)
+        {
+            if (c > 0) out += ',';
+            appendNumber(out, r.kicksPerSecond[c], "%.1f");
+        }
+        out += ']';
+    }
+    if (!r.tourFile.empty())
+    {
+        appendKey(out, "tour");        appendString(out, r.tourFile);
+    }
+    out += '}';
+    return out;
+}
+
+namespace
+{
+    // the string value of "key" in a flat JSON object written by toJsonLine()
+    bool readString(const std::string& line, const char* key, std::string& out)
+    {
+        const std::string pattern = std::string("\"") + key + "\":\"";
+        size_t i = line.find(pattern);
+        if (i == std::string::npos)
+            return false;
+
+        out.clear();
+        for (i += pattern.size(); i < line.size(); ++i)
+        {
+            const char c = line[i];
+            if (c == '"')
+                return true;
+            if (c != '\\')
+            {
+                out += c;
+                continue;
+            }
+
+            if (++i >= line.size())
+                return false;
+            switch (line[i])
+            {
+                case 'n': out += '\n'; break;
+                case 'r': out += '\r'; break;
+                case 't': out += '\t'; break;
+                case 'u':
+                    // toJsonLine() only escapes control characters this way
+                    if (i + 4 >= line.size())
+                        return false;
+                    out += static_cast<char>(std::stoi(line.substr(i + 1, 4), nullptr, 16));
+                    i += 4;
+                    break;
+                default: out += line[i]; break;
+            }
+        }
+        return false;
+    }
+}
+
+std::set<std::string> readSolvedInstances(const std::string& path)
+{
+    std::set<std::string> solved;
+    std::ifstream in(path);
+
+    std::string line;
+    while (std::getline(in, line))
+    {
+        while (!line.empty() && (line.back() == '\r' || line.back() == ' '))
+            line.pop_back();
+        if (line.size() < 2 || line.front() != '{' || line.back() != '}')
+            continue;
+        if (line.find("\"error\":") != std::string::npos)
+            continue;
+
+        std::string instance;
+        try
+        {
+            if (readString(line, "instance", instance))
+                solved.insert(instance);
+        }
+        catch (const std::exception&)
+        {
+            // a damaged escape; treat the line like an incomplete one
+        }
+    }
+    return solved;
+}
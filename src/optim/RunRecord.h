@@ -0,0 +1,29 @@
+#pragma once
+
+#include "OptimizerRun.h"
+
+#include <set>
+#include <string>
+#include <vector>
+
+// One solved instance, as reported by the command-line tools: one JSON object per line.
+// A record with an error only names the instance, the method and the error.
+struct RunRecord
+{
+    std::string instance;  // file the instance was loaded from
+    std::string name;      // NAME from the file
+    int cities = 0;
+    std::string method;
+    uint32_t seed = 0;
+    RunResult result;
+    std::vector<double> kicksPerSecond; // ILS pool: per chain over the run; empty for other methods
+    std::string tourFile;  // where the best tour was written, empty if it was not
+    std::string error;     // why the instance could not be solved, empty on success
+};
+
+std::string toJsonLine(const RunRecord& record);
+
+// Instances with a successful record in a results file written with toJsonLine(). Failed
+// records and incomplete lines (an interrupted write) do not count; a missing file is an
+// empty set.
+std::set<std::string> readSolvedInstances(const std::string& path);
@@ -52,18 +52,11 @@ bool SimAnnealOptimizer::iterate()
     const bool accept = (delta <= 0.0) || (std::exp(-delta / m_temp) > m_uni01(m_rng));
     if (accept)
     {
-        // apply move
+        // apply move; internal edges are symmetric, so the delta above is exact
         auto& ordMut = m_current.order();
         std::reverse(ordMut.begin() + i, ordMut.begin() + j + 1);
-        // update cost
-        // internal edges are symmetric, so the delta above is valid
-        const double newCost = m_current.cost() + delta;
-        // store without recomputing full O(n)
-        // (keep it consistent with potential numerical drift by a periodic full evaluate if needed)
-        // Here: just assign.
-        // NOTE: Tour::cost() is private; so we recompute occasionally? We'll do a light workaround:
-        m_current.evaluate(); // robust (O(n)), still reasonable for SA.
-        // If you want faster SA: add a setter for m_cost and skip evaluate().
+        m_current.setCost(m_current.cost() + delta);
+        m_best.recordReversal(i, j, m_current);
     }
 
     // cool down
@@ -72,8 +65,28 @@ bool SimAnnealOptimizer::iterate()
 
     if (m_current.cost() < m_best.cost())
     {
-        m_best = m_current;
+        m_best.markBest(m_current.cost());
         return true;
     }
     return false;
 }
+
+bool SimAnnealOptimizer::iterateBatch(int maxSteps, Clock::time_point deadline)
+{
+    return runBatch(*this, maxSteps, deadline, 1024);
+}
+
+bool SimAnnealOptimizer::inject(const std::vector<int>& order, double cost)
+{
+    if (static_cast<int>(order.size()) != m_current.size())
+        return false;
+
+    // snapshot our own best before the working tour stops being derived from it
+    m_best.best(m_current);
+
+    m_current.order().assign(order.begin(), order.end());
+    m_current.setCost(cost);
+    if (cost < m_best.cost())
+        m_best.markBest(cost);
+    return true;
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "IOptimizer.h"
+#include "BestTourJournal.h"
 #include <random>
 
 class SimAnnealOptimizer final : public IOptimizer
@@ -11,7 +12,9 @@ public:
                        double alpha = 0.999995);
 
     bool iterate() override;
-    const Tour& bestTour() const override { return m_best; }
+    bool iterateBatch(int maxSteps, Clock::time_point deadline) override;
+    bool inject(const std::vector<int>& order, double cost) override;
+    const Tour& bestTour() const override { return m_best.best(m_current); }
     double baselineCost() const override { return m_baseline; }
 
 private:
@@ -19,7 +22,7 @@ private:
     std::uniform_real_distribution<double> m_uni01;
 
     Tour m_current;
-    Tour m_best;
+    BestTourJournal m_best; // lazily materialized snapshot of the best m_current
 
     double m_baseline = 0.0;
     double m_temp = 1.0;
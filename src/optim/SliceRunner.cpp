@@ -0,0 +1,134 @@
+#include "SliceRunner.h"
+
+#include <algorithm>
+#include <limits>
+#include <thread>
+
+// length of a background slice; the stop flag is checked between slices
+static constexpr std::chrono::milliseconds kBackgroundSlice { 20 };
+
+SliceRunner::SliceRunner(int units, int threads, Slice slice)
+: m_units(std::max(0, units)),
+  m_threads(std::max(0, threads)),
+  m_slice(std::move(slice)),
+  m_busy(new std::atomic_bool[static_cast<size_t>(std::max(1, units))])
+{
+    for (int u = 0; u < m_units; ++u)
+        m_busy[u].store(false, std::memory_order_relaxed);
+}
+
+SliceRunner::~SliceRunner()
+{
+    stop();
+}
+
+bool SliceRunner::cancelled() const
+{
+    const CancellationToken* token = m_cancel.load(std::memory_order_relaxed);
+    return m_stop.load(std::memory_order_relaxed) || (token && token->cancelled());
+}
+
+int SliceRunner::acquire()
+{
+    for (int k = 0; k < m_units; ++k)
+    {
+        const int unit = static_cast<int>(m_next.fetch_add(1, std::memory_order_relaxed) % static_cast<unsigned>(m_units));
+        bool idle = false;
+        if (m_busy[unit].compare_exchange_strong(idle, true, std::memory_order_acquire, std::memory_order_relaxed))
+            return unit;
+    }
+    return -1;
+}
+
+void SliceRunner::release(int unit)
+{
+    m_busy[unit].store(false, std::memory_order_release);
+}
+
+int SliceRunner::claim()
+{
+    // a fair share of what is left, so one slice does not starve the others
+    long long left = m_budget.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        if (left <= 0)
+            return 0;
+        const long long grant = std::min<long long>(std::max<long long>(1, left / m_units), std::numeric_limits<int>::max());
+        if (m_budget.compare_exchange_weak(left, left - grant, std::memory_order_relaxed))
+            return static_cast<int>(grant);
+    }
+}
+
+bool SliceRunner::runUnit(int unit, Clock::time_point deadline)
+{
+    const int granted = claim();
+    if (granted == 0)
+        return false;
+
+    const long long taken = m_slice(unit, deadline, granted);
+    m_steps.fetch_add(taken, std::memory_order_relaxed);
+    m_budget.fetch_add(granted - taken, std::memory_order_relaxed);
+    return true;
+}
+
+void SliceRunner::background()
+{
+    bool worked = false;
+    const int unit = acquire();
+    if (unit >= 0)
+    {
+        worked = runUnit(unit, Clock::now() + kBackgroundSlice);
+        release(unit);
+    }
+
+    // with the budget used up, wait for the next run() to start over
+    if ((worked || unit < 0) && !cancelled())
+        m_tasks.requeue([this]{ background(); });
+    else
+        m_background.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void SliceRunner::run(long long stepLimit, Clock::time_point deadline)
+{
+    if (m_units == 0 || cancelled())
+        return;
+
+    m_budget.fetch_add(stepLimit - m_limit, std::memory_order_relaxed);
+    m_limit = stepLimit;
+
+    // the caller counts as one of the threads
+    TaskScheduler& pool = TaskScheduler::instance();
+    const int threads = (m_threads > 0) ? std::min(m_threads, pool.size()) : pool.size();
+    const int wanted = std::min(m_units, threads) - 1;
+    for (int b = m_background.load(std::memory_order_relaxed); b < wanted; ++b)
+    {
+        m_background.fetch_add(1, std::memory_order_relaxed);
+        m_tasks.run([this]{ background(); });
+    }
+
+    do
+    {
+        const int unit = acquire();
+        if (unit < 0)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        const bool worked = runUnit(unit, deadline);
+        release(unit);
+        if (worked)
+            continue;
+
+        // the budget is out: done once the running slices have returned their grants
+        if (steps() >= m_limit)
+            return;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    while (Clock::now() < deadline && !cancelled());
+}
+
+void SliceRunner::stop()
+{
+    m_stop.store(true, std::memory_order_relaxed);
+    m_tasks.wait();
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "../CancellationToken.h"
+#include "TaskScheduler.h"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+
+// Runs the units of a parallel optimizer (the islands of IslandGaOptimizer, the chains of
+// IlsPoolOptimizer, the children of PortfolioOptimizer) in time slices on the shared
+// TaskScheduler rather than on a thread each, so they compete for cores with every other
+// user of the scheduler instead of oversubscribing them. The thread that calls run() works
+// on a unit until the deadline it passes; up to threads - 1 scheduler tasks keep other units
+// going in between, each taking the next idle unit for one slice and then re-queueing itself
+// behind its worker's other work. With more units than threads the units take turns.
+// Steps are drawn from a shared budget before they are taken, so a step limit holds
+// exactly even though the units run on their own between calls.
+class SliceRunner
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Runs `unit` until `deadline` for at least one and at most `maxSteps` steps and returns
+    // the steps it took. A unit is run by one thread at a time and the next thread to pick
+    // it up sees everything the previous one wrote, so per-unit state needs no
+    // synchronization of its own.
+    using Slice = std::function<long long(int unit, Clock::time_point deadline, int maxSteps)>;
+
+    SliceRunner(int units, int threads, Slice slice); // threads: 0 = every scheduler thread
+    ~SliceRunner();
+
+    SliceRunner(const SliceRunner&) = delete;
+    SliceRunner& operator=(const SliceRunner&) = delete;
+
+    void setCancellation(const CancellationToken* token) { m_cancel.store(token, std::memory_order_relaxed); }
+
+    // Allows the units `stepLimit` steps in total, counted from the start, and starts the
+    // background tasks if they are not running. Then works on units from the calling thread
+    // until `deadline` (at least one slice) or until the limit is reached.
+    void run(long long stepLimit, Clock::time_point deadline);
+
+    // Ends the background tasks and waits for them. The owner calls it before the state its
+    // slices use is destroyed; run() does nothing afterwards.
+    void stop();
+
+    long long steps() const { return m_steps.load(std::memory_order_relaxed); }
+
+private:
+    int acquire(); // next idle unit, round robin; -1 if all are taken
+    void release(int unit);
+    int claim(); // steps granted from the budget, 0 if it is used up
+    bool runUnit(int unit, Clock::time_point deadline); // false if no steps were left
+    void background();
+    bool cancelled() const;
+
+    int m_units = 0;
+    int m_threads = 0;
+    Slice m_slice;
+
+    std::unique_ptr<std::atomic_bool[]> m_busy;
+    std::atomic<unsigned> m_next { 0 };
+    std::atomic<long long> m_steps { 0 };
+    std::atomic<long long> m_budget { 0 }; // limit - steps taken - steps granted to running slices
+    long long m_limit = 0;                 // run() only
+    std::atomic<int> m_background { 0 };
+    std::atomic_bool m_stop { false };
+    std::atomic<const CancellationToken*> m_cancel { nullptr };
+
+    TaskGroup m_tasks;
+};
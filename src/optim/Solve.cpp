@@ -0,0 +1,70 @@
+#include "Solve.h"
+
+#include "../TspInstance.h"
+#include "IlsPoolOptimizer.h"
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+
+// time between checks of the termination criteria and the cancellation token
+static constexpr std::chrono::milliseconds kSlice { 20 };
+
+bool isValidInit(const std::string& init)
+{
+    return init == "file" || init == "random" || init == "easy" || init == "thorough";
+}
+
+RunRecord solveInstance(SolveSpec spec, const CancellationToken* cancel)
+{
+    if (!isValidInit(spec.init))
+        throw std::invalid_argument("unknown starting tour: " + spec.init);
+
+    // draw the seed here, so the record can report it
+    if (!spec.params.has("seed"))
+        spec.params.set("seed", std::to_string(std::random_device{}()));
+    const uint32_t seed = spec.params.getSeed();
+
+    const TspInstance instance = TspInstance::loadFromTspFile(spec.instanceFile);
+    Tour initial(&instance);
+
+    if (spec.init == "random")
+    {
+        std::mt19937 rng(seed);
+        std::shuffle(initial.order().begin(), initial.order().end(), rng);
+        initial.evaluate();
+    }
+    else if (spec.init == "easy")
+    {
+        initial.easyHeuristic(cancel);
+    }
+    else if (spec.init == "thorough")
+    {
+        initial.thoroughHeuristic(cancel);
+    }
+
+    std::unique_ptr<IOptimizer> optimizer = makeOptimizer(spec.method, initial, spec.params);
+    optimizer->setCancellation(cancel);
+
+    // a mistyped parameter would otherwise silently run with the preset's value
+    const std::vector<std::string> unused = spec.params.unused();
+    if (!unused.empty())
+        throw std::invalid_argument("parameter " + unused.front() + " is not used by method " + spec.method);
+
+    RunRecord record;
+    record.result = runOptimizer(*optimizer, spec.criteria, cancel, kSlice);
+    record.instance = spec.instanceFile;
+    record.name = instance.name();
+    record.cities = instance.size();
+    record.method = spec.method;
+    record.seed = seed;
+    if (const auto* pool = dynamic_cast<const IlsPoolOptimizer*>(optimizer.get()))
+        record.kicksPerSecond = pool->kicksPerSecond();
+
+    if (!spec.tourFile.empty())
+    {
+        optimizer->bestTour().saveToTourFile(spec.tourFile);
+        record.tourFile = spec.tourFile;
+    }
+    return record;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "OptimizerFactory.h"
+#include "RunRecord.h"
+#include "TerminationCriteria.h"
+
+#include <string>
+
+// One instance from file to result record: the unit of work of tsp-solve and the batch
+// runner.
+struct SolveSpec
+{
+    std::string instanceFile;
+    std::string method = "ils";
+    OptimizerParams params;       // a random "seed" is drawn (and recorded) if unset
+    std::string init = "file";    // starting tour: file, random, easy, thorough
+    TerminationCriteria criteria;
+    std::string tourFile;         // best tour written here unless empty
+};
+
+// Loads, constructs, optimizes and writes the tour. `cancel` also interrupts the
+// construction heuristic. Throws std::runtime_error / std::invalid_argument on bad input.
+RunRecord solveInstance(SolveSpec spec, const CancellationToken* cancel);
+
+// true for the init names solveInstance() knows
+bool isValidInit(const std::string& init);
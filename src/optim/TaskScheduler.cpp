@@ -0,0 +1,290 @@
+#include "TaskScheduler.h"
+
+#include <algorithm>
+
+static thread_local const TaskScheduler* t_scheduler = nullptr;
+static thread_local int t_index = 0;
+
+namespace
+{
+    int defaultWorkers()
+    {
+        return static_cast<int>(std::max(1u, std::thread::hardware_concurrency())) - 1;
+    }
+
+    // One parallelFor() call. Helper tasks own a reference, so the ones that only start
+    // after the range is exhausted can still look at the counter once the caller is gone.
+    struct ForJob
+    {
+        const std::function<void(int)>* fn = nullptr;
+        std::atomic<int> next { 0 };
+        int end = 0;
+        int total = 0;
+        std::atomic<int> done { 0 };
+
+        std::mutex mutex;
+        std::condition_variable finished;
+        bool complete = false;
+
+        void drain()
+        {
+            int ran = 0;
+            for (;;)
+            {
+                const int i = next.fetch_add(1, std::memory_order_relaxed);
+                if (i >= end) break;
+                (*fn)(i);
+                ++ran;
+            }
+
+            if (ran > 0 && done.fetch_add(ran, std::memory_order_acq_rel) + ran == total)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                complete = true;
+                finished.notify_all();
+            }
+        }
+    };
+}
+
+TaskScheduler& TaskScheduler::instance()
+{
+    static TaskScheduler scheduler(defaultWorkers());
+    return scheduler;
+}
+
+void TaskScheduler::setWorkerCount(int workers)
+{
+    static std::mutex mutex;
+    std::lock_guard<std::mutex> lock(mutex);
+
+    TaskScheduler& s = instance();
+    s.stop();
+    s.start(workers > 0 ? workers : defaultWorkers());
+}
+
+TaskScheduler::TaskScheduler(int workers)
+{
+    start(workers);
+}
+
+TaskScheduler::~TaskScheduler()
+{
+    stop();
+}
+
+void TaskScheduler::start(int workers)
+{
+    m_quit = false;
+    m_queues.clear();
+    for (int w = 0; w < workers; ++w)
+        m_queues.push_back(std::make_unique<Queue>());
+
+    m_threads.reserve(static_cast<size_t>(workers));
+    for (int w = 0; w < workers; ++w)
+        m_threads.emplace_back([this, w]{ workerLoop(w); });
+}
+
+void TaskScheduler::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_quit = true;
+    }
+    m_wake.notify_all();
+    for (auto& t : m_threads)
+        t.join();
+    m_threads.clear();
+}
+
+int TaskScheduler::workerIndex() const
+{
+    return (t_scheduler == this) ? t_index + 1 : 0;
+}
+
+void TaskScheduler::submit(Task task)
+{
+    push(std::move(task), false);
+}
+
+void TaskScheduler::requeue(Task task)
+{
+    push(std::move(task), true);
+}
+
+void TaskScheduler::push(Task task, bool behind)
+{
+    if (m_queues.empty())
+    {
+        task();
+        return;
+    }
+
+    // workers push onto their own deque; everybody else spreads the work
+    const int self = (t_scheduler == this) ? t_index : -1;
+    const size_t q = (self >= 0) ? static_cast<size_t>(self)
+                                 : m_nextQueue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+    {
+        std::lock_guard<std::mutex> lock(m_queues[q]->mutex);
+        if (behind && self >= 0)
+            m_queues[q]->tasks.push_front(std::move(task));
+        else
+            m_queues[q]->tasks.push_back(std::move(task));
+    }
+    m_queued.fetch_add(1, std::memory_order_release);
+
+    // taking the lock orders the count against a worker about to sleep
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+    }
+    m_wake.notify_one();
+}
+
+bool TaskScheduler::runOne(int self)
+{
+    if (m_queued.load(std::memory_order_acquire) <= 0)
+        return false;
+
+    Task task;
+    const int queues = static_cast<int>(m_queues.size());
+
+    // own work, newest first (still warm in cache)
+    if (self >= 0)
+    {
+        Queue& own = *m_queues[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty())
+        {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+        }
+    }
+
+    // steal the oldest task of somebody else
+    for (int k = 1; !task && k <= queues; ++k)
+    {
+        Queue& victim = *m_queues[(std::max(self, 0) + k) % queues];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty())
+        {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+        }
+    }
+
+    if (!task)
+        return false;
+
+    m_queued.fetch_sub(1, std::memory_order_relaxed);
+    task();
+    return true;
+}
+
+void TaskScheduler::workerLoop(int index)
+{
+    t_scheduler = this;
+    t_index = index;
+
+    for (;;)
+    {
+        if (runOne(index))
+            continue;
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_wake.wait(lock, [this]{ return m_quit || m_queued.load(std::memory_order_acquire) > 0; });
+        if (m_quit && m_queued.load(std::memory_order_acquire) <= 0)
+            return;
+    }
+}
+
+void TaskScheduler::parallelFor(int begin, int end, const std::function<void(int)>& fn, int maxThreads)
+{
+    if (end <= begin) return;
+
+    int helpers = std::min(workerCount(), end - begin - 1);
+    if (maxThreads > 0)
+        helpers = std::min(helpers, maxThreads - 1);
+
+    // not worth waking anybody
+    if (helpers <= 0)
+    {
+        for (int i = begin; i < end; ++i) fn(i);
+        return;
+    }
+
+    auto job = std::make_shared<ForJob>();
+    job->fn = &fn;
+    job->next.store(begin, std::memory_order_relaxed);
+    job->end = end;
+    job->total = end - begin;
+
+    for (int h = 0; h < helpers; ++h)
+        submit([job]{ job->drain(); });
+
+    job->drain();
+
+    // wait until no helper is still running an index of this range
+    std::unique_lock<std::mutex> lock(job->mutex);
+    job->finished.wait(lock, [&]{ return job->complete; });
+}
+
+TaskGroup::TaskGroup(TaskScheduler& scheduler)
+: m_scheduler(scheduler)
+{
+}
+
+void TaskGroup::run(std::function<void()> fn)
+{
+    add(std::move(fn), false);
+}
+
+void TaskGroup::requeue(std::function<void()> fn)
+{
+    add(std::move(fn), true);
+}
+
+void TaskGroup::add(std::function<void()> fn, bool behind)
+{
+    if (m_scheduler.workerCount() == 0)
+    {
+        fn();
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_pending;
+    }
+    TaskScheduler::Task task = [this, fn = std::move(fn)]
+    {
+        fn();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--m_pending == 0)
+            m_done.notify_all();
+    };
+    if (behind)
+        m_scheduler.requeue(std::move(task));
+    else
+        m_scheduler.submit(std::move(task));
+}
+
+void TaskGroup::wait()
+{
+    const int self = (t_scheduler == &m_scheduler) ? t_index : -1;
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    // a worker must not block: the tasks it waits for may sit in its own deque
+    if (self >= 0)
+    {
+        while (m_pending > 0)
+        {
+            lock.unlock();
+            if (!m_scheduler.runOne(self))
+                std::this_thread::yield();
+            lock.lock();
+        }
+        return;
+    }
+
+    m_done.wait(lock, [this]{ return m_pending == 0; });
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Process-wide work-stealing scheduler shared by every optimizer, so that the GUI worker,
+// a portfolio and batch jobs running side by side draw on one set of threads instead of
+// each spinning up their own. Every worker owns a deque: it pushes and pops its own tasks
+// at the back and, when it runs dry, steals from the front of the others'. Threads outside
+// the scheduler submit round-robin. parallelFor() and TaskGroup are the fork/join helpers.
+class TaskScheduler
+{
+public:
+    using Task = std::function<void()>;
+
+    static TaskScheduler& instance();
+
+    // Restarts the shared scheduler with `workers` threads (0 = one per core, less the
+    // caller's). Call it while no work is in flight and before creating parallel
+    // optimizers: their per-thread scratch is sized from size().
+    static void setWorkerCount(int workers);
+
+    ~TaskScheduler();
+
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+    int workerCount() const { return static_cast<int>(m_threads.size()); }
+
+    // Threads that may run a parallelFor() body: the workers plus the calling thread.
+    int size() const { return workerCount() + 1; }
+
+    // Index of the calling thread in [0, size()): 0 outside the scheduler, 1.. for workers.
+    // Lets kernels keep per-thread scratch buffers.
+    int workerIndex() const;
+
+    // Runs fn(i) for every i in [begin, end) and returns once all of them are done. The
+    // caller takes part; at most maxThreads threads (0 = no limit) work on the range.
+    void parallelFor(int begin, int end, const std::function<void(int)>& fn, int maxThreads = 0);
+
+    // Queues a task; fire-and-forget (use TaskGroup to wait for it).
+    void submit(Task task);
+
+    // Like submit(), but a worker queues the task at the far end of its own deque, behind
+    // its other work and first in line for thieves. A long loop that re-queues itself one
+    // slice at a time this way takes turns with the tasks queued after it.
+    void requeue(Task task);
+
+private:
+    friend class TaskGroup;
+
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    explicit TaskScheduler(int workers);
+
+    void start(int workers);
+    void stop();
+    void workerLoop(int index);
+    void push(Task task, bool behind);
+    bool runOne(int self); // own queue first, then steal; false if every queue was empty
+
+    std::vector<std::unique_ptr<Queue>> m_queues;
+    std::vector<std::thread> m_threads;
+
+    std::atomic<int> m_queued { 0 };
+    std::atomic<unsigned> m_nextQueue { 0 }; // round-robin target for outside submissions
+
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+    bool m_quit = false;
+};
+
+// Fork/join over the scheduler: run() forks a task, wait() joins all of them. A worker
+// thread that waits keeps executing queued tasks instead of blocking.
+class TaskGroup
+{
+public:
+    explicit TaskGroup(TaskScheduler& scheduler = TaskScheduler::instance());
+    ~TaskGroup() { wait(); }
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    void run(std::function<void()> fn);
+    void requeue(std::function<void()> fn); // run() through TaskScheduler::requeue()
+    void wait();
+
+private:
+    void add(std::function<void()> fn, bool behind);
+
+    TaskScheduler& m_scheduler;
+
+    std::mutex m_mutex;
+    std::condition_variable m_done;
+    int m_pending = 0;
+};
@@ -0,0 +1,116 @@
+#include "TerminationCriteria.h"
+
+#include <algorithm>
+#include <ctime>
+#include <limits>
+
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+
+bool TerminationCriteria::any() const
+{
+    return wallSeconds > 0.0 || cpuSeconds > 0.0 || maxSteps > 0
+        || targetCost > 0.0 || (referenceCost > 0.0 && targetGapPercent >= 0.0)
+        || stagnationSeconds > 0.0 || stagnationSteps > 0;
+}
+
+const char* terminationReasonName(TerminationReason reason)
+{
+    switch (reason)
+    {
+        case TerminationReason::None:            return "none";
+        case TerminationReason::Cancelled:       return "cancelled";
+        case TerminationReason::WallTime:        return "time limit";
+        case TerminationReason::CpuTime:         return "CPU time limit";
+        case TerminationReason::StepLimit:       return "step limit";
+        case TerminationReason::TargetCost:      return "target cost";
+        case TerminationReason::TargetGap:       return "target gap";
+        case TerminationReason::StagnationTime:  return "no improvement (time)";
+        case TerminationReason::StagnationSteps: return "no improvement (steps)";
+    }
+    return "unknown";
+}
+
+TerminationMonitor::TerminationMonitor(const TerminationCriteria& criteria, double initialCost)
+: m_criteria(criteria),
+  m_start(Clock::now()),
+  m_cpuStart(cpuNow()),
+  m_bestCost(initialCost),
+  m_lastImprovement(m_start)
+{
+}
+
+double TerminationMonitor::elapsedSeconds() const
+{
+    return std::chrono::duration<double>(Clock::now() - m_start).count();
+}
+
+double TerminationMonitor::cpuNow() const
+{
+    if (m_criteria.cpuClock == TerminationCriteria::CpuClock::Process)
+    {
+        // std::clock() is process CPU time on POSIX (wall time on Windows)
+        return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+    }
+
+#if defined(_WIN32)
+    FILETIME created, exited, kernel, user;
+    GetThreadTimes(GetCurrentThread(), &created, &exited, &kernel, &user);
+    const auto ticks = [](const FILETIME& t){ return (static_cast<unsigned long long>(t.dwHighDateTime) << 32) | t.dwLowDateTime; };
+    return static_cast<double>(ticks(kernel) + ticks(user)) * 1e-7; // 100 ns units
+#else
+    timespec ts {};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) * 1e-9;
+#endif
+}
+
+double TerminationMonitor::cpuSeconds() const
+{
+    return cpuNow() - m_cpuStart;
+}
+
+TerminationReason TerminationMonitor::check(long long steps, double bestCost)
+{
+    const auto now = Clock::now();
+    if (bestCost < m_bestCost)
+    {
+        m_bestCost = bestCost;
+        m_lastImprovement = now;
+        m_secondsToBest = std::chrono::duration<double>(now - m_start).count();
+        m_stepsToBest = steps;
+    }
+
+    const TerminationCriteria& c = m_criteria;
+
+    if (c.targetCost > 0.0 && m_bestCost <= c.targetCost)
+        return TerminationReason::TargetCost;
+    if (c.referenceCost > 0.0 && c.targetGapPercent >= 0.0
+        && (m_bestCost - c.referenceCost) / c.referenceCost * 100.0 <= c.targetGapPercent)
+        return TerminationReason::TargetGap;
+
+    if (c.wallSeconds > 0.0 && std::chrono::duration<double>(now - m_start).count() >= c.wallSeconds)
+        return TerminationReason::WallTime;
+    if (c.cpuSeconds > 0.0 && cpuSeconds() >= c.cpuSeconds)
+        return TerminationReason::CpuTime;
+    if (c.maxSteps > 0 && steps >= c.maxSteps)
+        return TerminationReason::StepLimit;
+
+    if (c.stagnationSeconds > 0.0 && std::chrono::duration<double>(now - m_lastImprovement).count() >= c.stagnationSeconds)
+        return TerminationReason::StagnationTime;
+    if (c.stagnationSteps > 0 && steps - m_stepsToBest >= c.stagnationSteps)
+        return TerminationReason::StagnationSteps;
+
+    return TerminationReason::None;
+}
+
+long long TerminationMonitor::stepBudget(long long steps) const
+{
+    long long budget = std::numeric_limits<long long>::max();
+    if (m_criteria.maxSteps > 0)
+        budget = std::min(budget, m_criteria.maxSteps - steps);
+    if (m_criteria.stagnationSteps > 0)
+        budget = std::min(budget, m_stepsToBest + m_criteria.stagnationSteps - steps);
+    return std::max(1LL, budget);
+}
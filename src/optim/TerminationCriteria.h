@@ -0,0 +1,80 @@
+#pragma once
+
+#include <chrono>
+
+// When an unattended run should stop. Every criterion is off by default; with none set,
+// a run only ends when it is cancelled.
+struct TerminationCriteria
+{
+    double wallSeconds = 0.0;        // wall-clock budget (0 = none)
+    double cpuSeconds = 0.0;         // CPU budget, measured as cpuClock says (0 = none)
+    long long maxSteps = 0;          // optimizer steps, see IOptimizer::steps() (0 = none)
+
+    double targetCost = 0.0;         // stop once the best costs at most this (0 = none)
+    double referenceCost = 0.0;      // known optimum or lower bound, for targetGapPercent
+    double targetGapPercent = -1.0;  // stop within this gap above referenceCost (< 0 = none)
+
+    // no improvement of the best for this long
+    double stagnationSeconds = 0.0;  // (0 = none)
+    long long stagnationSteps = 0;   // (0 = none)
+
+    // Process: all threads of the process, right when the run has the process to itself.
+    // Thread: only the thread running the monitor, for runs confined to that thread while
+    // others share the process (the batch runner's single-threaded slots).
+    enum class CpuClock { Process, Thread };
+    CpuClock cpuClock = CpuClock::Process;
+
+    bool any() const;
+};
+
+enum class TerminationReason
+{
+    None,            // still running
+    Cancelled,       // stopped from outside
+    WallTime,
+    CpuTime,
+    StepLimit,
+    TargetCost,
+    TargetGap,
+    StagnationTime,
+    StagnationSteps
+};
+
+const char* terminationReasonName(TerminationReason reason);
+
+// Evaluates TerminationCriteria for one run, between optimizer batches. It only sees the
+// best cost after each batch, so the time criteria fire within one batch of their limit;
+// stepBudget() lets the caller size batches so that the step criteria fire exactly.
+class TerminationMonitor
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    TerminationMonitor(const TerminationCriteria& criteria, double initialCost);
+
+    // After a batch: the optimizer's total steps and its best cost. Returns the first
+    // criterion that holds (targets before budgets before stagnation), or None.
+    TerminationReason check(long long steps, double bestCost);
+
+    // Most steps the next batch may take before a step criterion is due.
+    long long stepBudget(long long steps) const;
+
+    double elapsedSeconds() const;
+    double secondsToBest() const { return m_secondsToBest; } // time of the last improvement
+    long long stepsToBest() const { return m_stepsToBest; }
+    double bestCost() const { return m_bestCost; }
+
+private:
+    double cpuSeconds() const;
+    double cpuNow() const;
+
+    TerminationCriteria m_criteria;
+
+    Clock::time_point m_start;
+    double m_cpuStart;
+
+    double m_bestCost;
+    Clock::time_point m_lastImprovement;
+    double m_secondsToBest = 0.0;
+    long long m_stepsToBest = 0;
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Lock-free single-producer/single-consumer triple buffer.
+// The writer fills back() and publish()es it; the reader calls update() and then reads
+// front(), which is the most recently published value. Neither side ever waits or
+// allocates, and publications the reader has not picked up yet are simply replaced by
+// newer ones (coalesced).
+template <typename T>
+class TripleBuffer
+{
+public:
+    TripleBuffer() = default;
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // --- writer side ---
+    T& back() { return m_slots[m_back]; }
+
+    void publish()
+    {
+        const uint8_t prev = m_middle.exchange(static_cast<uint8_t>(m_back | kFresh), std::memory_order_acq_rel);
+        m_back = prev & kIndex;
+    }
+
+    // true while the last publication has not been picked up by the reader
+    bool unread() const { return (m_middle.load(std::memory_order_acquire) & kFresh) != 0; }
+
+    // --- reader side ---
+    // Makes the latest publication available as front(); false if there was none.
+    bool update()
+    {
+        if (!unread())
+            return false;
+        const uint8_t prev = m_middle.exchange(m_front, std::memory_order_acq_rel);
+        m_front = prev & kIndex;
+        return true;
+    }
+
+    const T& front() const { return m_slots[m_front]; }
+
+private:
+    static constexpr uint8_t kIndex = 3;
+    static constexpr uint8_t kFresh = 4;
+
+    T m_slots[3];
+    uint8_t m_back = 0;                  // writer only
+    std::atomic<uint8_t> m_middle { 1 }; // index | kFresh
+    uint8_t m_front = 2;                 // reader only
+};
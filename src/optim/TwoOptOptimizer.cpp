@@ -82,14 +82,35 @@ bool TwoOptOptimizer::iterate()
     if (bestI >= 0)
     {
         std::reverse(ord.begin() + bestI, ord.begin() + bestJ + 1);
-        m_current.evaluate();
+        m_current.setCost(m_current.cost() + bestDelta);
+        m_best.recordReversal(bestI, bestJ, m_current);
 
         if (m_current.cost() < m_best.cost())
         {
-            m_best = m_current;
+            m_best.markBest(m_current.cost());
             return true;
         }
     }
 
     return false;
 }
+
+bool TwoOptOptimizer::iterateBatch(int maxSteps, Clock::time_point deadline)
+{
+    return runBatch(*this, maxSteps, deadline, 16);
+}
+
+bool TwoOptOptimizer::inject(const std::vector<int>& order, double cost)
+{
+    if (static_cast<int>(order.size()) != m_current.size())
+        return false;
+
+    // snapshot our own best before the working tour stops being derived from it
+    m_best.best(m_current);
+
+    m_current.order().assign(order.begin(), order.end());
+    m_current.setCost(cost);
+    if (cost < m_best.cost())
+        m_best.markBest(cost);
+    return true;
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "IOptimizer.h"
+#include "BestTourJournal.h"
 
 #include <random>
 #include <vector>
@@ -15,7 +16,9 @@ public:
                              uint32_t seed = std::random_device{}());
 
     bool iterate() override;
-    const Tour& bestTour() const override { return m_best; }
+    bool iterateBatch(int maxSteps, Clock::time_point deadline) override;
+    bool inject(const std::vector<int>& order, double cost) override;
+    const Tour& bestTour() const override { return m_best.best(m_current); }
     double baselineCost() const override { return m_baseline; }
 
 private:
@@ -29,6 +32,6 @@ private:
     std::mt19937 m_rng;
 
     Tour m_current;
-    Tour m_best;
+    BestTourJournal m_best; // lazily materialized snapshot of the best m_current
     double m_baseline = 0.0;
 };